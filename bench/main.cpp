@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <ostream>
+#include <print>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../gen/generators.hpp"
+#include "days.hpp"
+
+using nanoseconds = std::chrono::duration<double, std::nano>;
+
+struct options {
+    std::optional<int> day;
+    std::optional<int> part;
+    std::vector<std::uint64_t> scales{1, 2, 4};
+    int repeat{5};
+    std::uint64_t seed{0};
+    std::optional<std::string> json;
+};
+
+struct measurement {
+    int day;
+    int part;
+    std::uint64_t scale;
+    std::size_t bytes;
+    std::size_t elements;
+    std::string answer;
+    nanoseconds parse;
+    nanoseconds solve;
+
+    [[nodiscard]] double parse_per_element() const { return parse.count() / static_cast<double>(elements); }
+    [[nodiscard]] double solve_per_element() const { return solve.count() / static_cast<double>(elements); }
+
+    /// MB/s over the whole part, parsing and solving
+    [[nodiscard]] double throughput() const { return static_cast<double>(bytes) * 1e3 / (parse + solve).count(); }
+};
+
+std::uint64_t parse_uint(const std::string_view flag, const std::string_view value) {
+    std::uint64_t result;
+    if (const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+        ec != std::errc{} || ptr != value.data() + value.size())
+        throw std::invalid_argument(std::format("{} expects a non-negative integer, got '{}'", flag, value));
+    return result;
+}
+
+options parse_options(const std::span<char *> args) {
+    options result{};
+    for (auto it = args.begin(); it != args.end(); ++it) {
+        const std::string_view flag{*it};
+        if (it + 1 == args.end()) throw std::invalid_argument(std::format("{} expects a value", flag));
+        const std::string_view value{*++it};
+        if (flag == "--day")
+            result.day = static_cast<int>(parse_uint(flag, value));
+        else if (flag == "--part")
+            result.part = static_cast<int>(parse_uint(flag, value));
+        else if (flag == "--scales")
+            result.scales = value
+                    | std::views::split(',')
+                    | std::views::transform([&](auto &&s) { return parse_uint(flag, std::string_view{s}); })
+                    | std::ranges::to<std::vector>();
+        else if (flag == "--repeat")
+            result.repeat = static_cast<int>(parse_uint(flag, value));
+        else if (flag == "--seed")
+            result.seed = parse_uint(flag, value);
+        else if (flag == "--json")
+            result.json = std::string{value};
+        else
+            throw std::invalid_argument(std::format("unknown flag {}", flag));
+    }
+    if (result.repeat < 1) throw std::invalid_argument("--repeat must be at least 1");
+    if (std::ranges::contains(result.scales, 0u)) throw std::invalid_argument("--scales must be at least 1");
+    return result;
+}
+
+void print_usage() {
+    std::println("Usage: aoc_bench [--day N] [--part P] [--scales 1,2,4] [--repeat N] [--seed S] [--json FILE]");
+    std::println("  --day N        only benchmark day N (default: every day)");
+    std::println("  --part P       only benchmark part P (default: every part)");
+    std::println("  --scales LIST  generated input sizes, relative to the assignment (default: 1,2,4)");
+    std::println("  --repeat N     runs per input, the fastest parse and solve times are kept (default: 5)");
+    std::println("  --seed S       seed for the generated inputs (default: 0)");
+    std::println("  --json FILE    additionally write the results to FILE");
+}
+
+/// lines for most days. Single-line inputs (d02) are comma-separated, so those count as elements instead.
+std::size_t count_elements(const std::string_view input) {
+    const auto lines = std::ranges::count_if(input | std::views::split('\n'),
+                                             [](auto &&line) { return !std::ranges::empty(line); });
+    if (lines > 1) return lines;
+    return std::ranges::count(input, ',') + 1;
+}
+
+measurement measure(const aoc::part_entry &entry, const std::uint64_t scale, const std::string &input,
+                    const int repeat) {
+    measurement result{.day = entry.day,
+                       .part = entry.part,
+                       .scale = scale,
+                       .bytes = input.size(),
+                       .elements = count_elements(input),
+                       .parse = nanoseconds::max(),
+                       .solve = nanoseconds::max()};
+    for (int i = 0; i < repeat; ++i) {
+        auto [answer, parse_time, solve_time] = entry.run(input);
+        result.answer = std::move(answer);
+        result.parse = std::min(result.parse, nanoseconds{parse_time});
+        result.solve = std::min(result.solve, nanoseconds{solve_time});
+    }
+    return result;
+}
+
+void write_json(std::ostream &out, const options &opts, const std::vector<measurement> &results) {
+    std::println(out, "{{");
+    std::println(out, R"(  "version": "{}",)", AOC_VERSION);
+    std::println(out, R"(  "seed": {},)", opts.seed);
+    std::println(out, R"(  "repeat": {},)", opts.repeat);
+    std::println(out, R"(  "results": [)");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto &m = results[i];
+        std::println(out,
+                     R"(    {{"day": {}, "part": {}, "scale": {}, "bytes": {}, "elements": {}, "answer": "{}", )"
+                     R"("parse_ns": {:.0f}, "solve_ns": {:.0f}, "parse_ns_per_element": {:.3f}, )"
+                     R"("solve_ns_per_element": {:.3f}, "throughput_mb_s": {:.3f}}}{})",
+                     m.day, m.part, m.scale, m.bytes, m.elements, m.answer, m.parse.count(), m.solve.count(),
+                     m.parse_per_element(), m.solve_per_element(), m.throughput(), i + 1 == results.size() ? "" : ",");
+    }
+    std::println(out, "  ]");
+    std::println(out, "}}");
+}
+
+int main(const int argc, char **argv) {
+    options opts;
+    try {
+        opts = parse_options({argv + 1, argv + argc});
+    } catch (const std::invalid_argument &e) {
+        std::println(stderr, "{}", e.what());
+        print_usage();
+        return 1;
+    }
+
+    const auto parts = aoc::all_parts();
+    std::vector<measurement> results{};
+    std::println("{:>3} {:>4} {:>6} {:>12} {:>10} | {:>12} {:>10} | {:>12} {:>10} | {:>10}", "day", "part", "scale",
+                 "bytes", "elements", "parse ms", "ns/elem", "solve ms", "ns/elem", "MB/s");
+    for (int day = 1; day <= 12; ++day) {
+        if (opts.day && day != *opts.day) continue;
+        for (const auto scale: opts.scales) {
+            // every part of a day sees the same input
+            const auto input = gen::generate(day, opts.seed, {.scale = scale});
+            for (const auto &entry: parts) {
+                if (entry.day != day || (opts.part && entry.part != *opts.part)) continue;
+                try {
+                    const auto &m = results.emplace_back(measure(entry, scale, input, opts.repeat));
+                    std::println("{:>3} {:>4} {:>6} {:>12} {:>10} | {:>12.3f} {:>10.2f} | {:>12.3f} {:>10.2f} | "
+                                 "{:>10.1f}",
+                                 m.day, m.part, m.scale, m.bytes, m.elements, m.parse.count() / 1e6,
+                                 m.parse_per_element(), m.solve.count() / 1e6, m.solve_per_element(), m.throughput());
+                } catch (const std::exception &e) {
+                    std::println(stderr, "day {:02} part {} failed at scale {}: {}", entry.day, entry.part, scale,
+                                 e.what());
+                }
+            }
+        }
+    }
+
+    if (opts.json) {
+        std::ofstream out{*opts.json};
+        if (!out) {
+            std::println(stderr, "can't open {}", *opts.json);
+            return 1;
+        }
+        write_json(out, opts, results);
+    }
+    return 0;
+}
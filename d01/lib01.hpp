@@ -0,0 +1,141 @@
+#ifndef LIB01_HPP
+#define LIB01_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <input.hpp>
+#include <parallel.hpp>
+
+/// a single dial instruction, `L68` is stored as -68 and `R48` as 48.
+using rotation = int;
+
+inline std::vector<rotation> parse_rotations(const std::string_view input) {
+    util::scanner s{input};
+    std::vector<rotation> rotations{};
+    char dir;
+    int amount;
+    while (s.read(dir) && s.read(amount))
+        rotations.push_back(dir == 'R' ? amount : -amount);
+    return rotations;
+}
+
+/// counts how often the dial comes to rest on 0.
+inline long long count_zero_stops(const std::vector<rotation> &rotations) {
+    int pos{50};
+    long long count{0};
+    for (const rotation r: rotations) {
+        pos = (pos + r % 100 + 100) % 100;
+        if (pos == 0) ++count;
+    }
+    return count;
+}
+
+/// counts how often the dial points at 0, including every click during a rotation.
+inline long long count_zero_passes(const std::vector<rotation> &rotations) {
+    int pos{50};
+    long long count{0};
+    for (const rotation r: rotations) {
+        const auto amount = r < 0 ? -r : r;
+        const auto full_rotations = amount / 100;
+        const auto remainder = amount % 100;
+        count += full_rotations;
+        if (r > 0 && remainder >= 100 - pos || pos != 0 && r < 0 && remainder >= pos) ++count;
+        pos = (pos + r % 100 + 100) % 100;
+    }
+    return count;
+}
+
+/*
+ * The same counts, for rotation logs too long for a single core.
+ *
+ * Where the dial ends up after a sequence of rotations only shifts with the start position, and how often it hit 0 on
+ * the way depends on nothing but the start position. So the effect of a sequence can be stored for all 100 start
+ * positions at once, and two such effects compose in O(100). Composition is associative, so the log can be cut into
+ * chunks which are solved independently and combined in order afterwards.
+ */
+
+/// effect of a sequence of rotations: the dial moves by `offset`, and passes 0 `zeros[start]` times.
+struct dial_transform {
+    int offset{0};
+    std::array<long long, 100> zeros{};
+};
+
+/// `a` followed by `b`.
+inline dial_transform compose(const dial_transform &a, const dial_transform &b) {
+    dial_transform result{.offset = (a.offset + b.offset) % 100};
+    for (auto start{0}; start < 100; ++start)
+        result.zeros[start] = a.zeros[start] + b.zeros[(start + a.offset) % 100];
+    return result;
+}
+
+/// the transform of a chunk, in O(n + 100) instead of simulating all 100 start positions.
+/// @tparam CountPasses count every click on 0 (part 2) instead of only stops (part 1)
+template<bool CountPasses>
+dial_transform chunk_transform(const std::span<const rotation> rotations) {
+    // every rotation hits 0 for a contiguous range of current positions. Shifted back by the offset so far, that's a
+    // (wrapping) range of start positions, which is recorded in a difference array.
+    std::array<long long, 101> diff{};
+    long long all_starts{0};
+    auto offset{0};
+    const auto add = [&](const int from, const int to) {
+        const auto first = (from - offset + 100) % 100;
+        const auto last = first + to - from + 1;
+        ++diff[first];
+        if (last <= 100) {
+            --diff[last];
+        } else {
+            --diff[100];
+            ++diff[0];
+            --diff[last - 100];
+        }
+    };
+    for (const rotation r: rotations) {
+        if constexpr (CountPasses) {
+            const auto amount = r < 0 ? -r : r;
+            all_starts += amount / 100;
+            if (const auto remainder = amount % 100; remainder != 0) {
+                if (r > 0)
+                    add(100 - remainder, 99);
+                else
+                    add(1, remainder);
+            }
+        }
+        offset = (offset + r % 100 + 100) % 100;
+        if constexpr (!CountPasses) add(0, 0);
+    }
+    dial_transform result{.offset = offset};
+    long long running{0};
+    for (auto start{0}; start < 100; ++start) {
+        running += diff[start];
+        result.zeros[start] = all_starts + running;
+    }
+    return result;
+}
+
+/// zero hits for every start position of the dial, from a single pass over the log on all cores of the shared pool.
+/// Logs shorter than a single chunk are solved on the calling thread.
+template<bool CountPasses, std::size_t Chunk = 1 << 16>
+std::array<long long, 100> count_zeros_all_starts(const std::vector<rotation> &rotations) {
+    const auto chunk_count = (rotations.size() + Chunk - 1) / Chunk;
+    return util::parallel_reduce(
+                   std::size_t{0}, chunk_count, dial_transform{},
+                   [&](const std::size_t c) {
+                       const auto from = c * Chunk;
+                       return chunk_transform<CountPasses>(
+                               std::span{rotations}.subspan(from, std::min(Chunk, rotations.size() - from)));
+                   },
+                   compose, 1)
+            .zeros;
+}
+
+template<bool CountPasses, std::size_t Chunk = 1 << 16>
+long long count_zeros_parallel(const std::vector<rotation> &rotations) {
+    return count_zeros_all_starts<CountPasses, Chunk>(rotations)[50];
+}
+
+#endif // LIB01_HPP
@@ -1,20 +1,22 @@
 #include <iostream>
-#include <fstream>
-#include <format>
+#include <string_view>
 
-int main() {
-    // std::ifstream f{"../../d01/sample.txt"};
-    std::ifstream f{"../../d01/assignment.txt"};
-    int pos{50}, count{0};
-    char dir;
-    int amount;
-    while (f >> dir >> amount) {
-        const auto full_rotations = amount / 100;
-        const auto remainder = amount % 100;
-        count += full_rotations;
-        if (dir == 'R' && remainder >= 100 - pos || pos != 0 && dir == 'L' && remainder >= pos) ++count;
-        pos = (pos + (dir == 'R' ? amount : -amount) % 100 + 100) % 100;
+#include <input.hpp>
+
+#include "lib01.hpp"
+
+int main(const int argc, char **argv) {
+    // const util::mapped_file f{"../../d01/sample.txt"};
+    const util::mapped_file f{"../../d01/assignment.txt"};
+    const auto rotations = parse_rotations(f.view());
+
+    // --all-starts prints the result for every position the dial could start at, instead of only 50.
+    if (argc > 1 && std::string_view{argv[1]} == "--all-starts") {
+        const auto counts = count_zeros_all_starts<true>(rotations);
+        for (auto start{0}; start < 100; ++start)
+            std::cout << "Start " << start << ": " << counts[start] << std::endl;
+        return 0;
     }
-    std::cout << "Result: " << count << std::endl;
+    std::cout << "Result: " << count_zeros_parallel<true>(rotations) << std::endl;
     return 0;
 }
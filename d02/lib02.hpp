@@ -0,0 +1,194 @@
+#ifndef LIB02_HPP
+#define LIB02_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <input.hpp>
+#include <parallel.hpp>
+
+using product_range = std::pair<std::uint64_t, std::uint64_t>;
+
+inline std::vector<product_range> parse_product_ranges(const std::string_view input) {
+    util::scanner s{input};
+    std::vector<product_range> ranges{};
+    std::uint64_t a, b;
+    char dash, comma;
+    while (s.read(a) && s.read(dash) && s.read(b)) {
+        ranges.emplace_back(a, b);
+        s.read(comma);
+    }
+    return ranges;
+}
+
+/*
+ * Instead of checking every id, the invalid ids can be enumerated directly.
+ * An id with `length` digits made of a block of `period` digits repeated `length / period` times is block * r, with
+ * r = 1 + 10^period + 10^(2 period) + ... (e.g. 123123 = 123 * 1001). The blocks that land inside [a; b] are a
+ * contiguous range, so their sum is an arithmetic series.
+ *
+ * For part 2, an id can be repeated with several periods (111111 has period 1, 2 and 3), so summing over every period
+ * would count it multiple times. The ids with period p and q are exactly those with period gcd(p, q), so inclusion-
+ * exclusion over the prime factors d of `length` (the periods length / d), i.e. the Möbius function, counts each once.
+ *
+ * All sums are modulo 2^64, just like the brute force in `verify_invalid_ids`.
+ */
+
+/// 10^e, for e in [0; 19]
+constexpr std::uint64_t pow10(const int e) {
+    std::uint64_t result{1};
+    for (auto i{0}; i < e; ++i)
+        result *= 10;
+    return result;
+}
+
+constexpr int digit_count(std::uint64_t n) {
+    auto count{1};
+    for (; n >= 10; n /= 10)
+        ++count;
+    return count;
+}
+
+/// 1 + 10^period + 10^(2 period) + ..., up to `length` digits. Multiplying a block of `period` digits by this repeats it.
+constexpr std::uint64_t repetition_factor(const int length, const int period) {
+    std::uint64_t r{0};
+    for (auto shift{0}; shift < length; shift += period)
+        r += pow10(shift);
+    return r;
+}
+
+/// sum of first + (first + 1) + ... + last, modulo 2^64.
+constexpr std::uint64_t series_sum(const std::uint64_t first, const std::uint64_t last) {
+    const auto count = last - first + 1;
+    const auto ends = first + last;
+    // one of the two factors is even, halve that one before multiplying.
+    return count % 2 == 0 ? count / 2 * ends : ends / 2 * count;
+}
+
+/// sum of the ids in [a; b] with exactly `length` digits that are a block of `period` digits repeated.
+constexpr std::uint64_t sum_repeated(const std::uint64_t a, const std::uint64_t b, const int length, const int period) {
+    const auto lo = std::max(a, pow10(length - 1));
+    const auto hi = std::min(b, length >= 20 ? UINT64_MAX : pow10(length) - 1);
+    if (lo > hi) return 0;
+    const auto r = repetition_factor(length, period);
+    const auto first_block = std::max(lo / r + (lo % r != 0), pow10(period - 1));
+    const auto last_block = std::min(hi / r, pow10(period) - 1);
+    if (first_block > last_block) return 0;
+    return series_sum(first_block, last_block) * r;
+}
+
+/// -1 if n has an odd amount of distinct prime factors, 1 if even, 0 if any prime divides n twice.
+constexpr int mobius(int n) {
+    auto result{1};
+    for (auto p{2}; p * p <= n; ++p) {
+        if (n % p != 0) continue;
+        n /= p;
+        if (n % p == 0) return 0;
+        result = -result;
+    }
+    return n > 1 ? -result : result;
+}
+
+/// part 1 of a single range, without looking at the individual ids.
+constexpr std::uint64_t sum_doubled_ids(const std::uint64_t a, const std::uint64_t b) {
+    std::uint64_t sum{0};
+    for (auto length{digit_count(a)}; length <= digit_count(b); ++length)
+        if (length % 2 == 0) sum += sum_repeated(a, b, length, length / 2);
+    return sum;
+}
+
+/// part 2 of a single range, without looking at the individual ids.
+constexpr std::uint64_t sum_repeated_ids(const std::uint64_t a, const std::uint64_t b) {
+    std::uint64_t sum{0};
+    for (auto length{digit_count(a)}; length <= digit_count(b); ++length)
+        for (auto d{2}; d <= length; ++d)
+            if (length % d == 0 && mobius(d) != 0)
+                sum -= static_cast<std::uint64_t>(mobius(d)) * sum_repeated(a, b, length, length / d);
+    return sum;
+}
+
+static_assert(sum_doubled_ids(11, 22) == 11 + 22);
+static_assert(sum_doubled_ids(95, 115) == 99);
+static_assert(sum_doubled_ids(998, 1012) == 1010);
+static_assert(sum_repeated_ids(95, 115) == 99 + 111);
+static_assert(sum_repeated_ids(998, 1012) == 999 + 1010);
+static_assert(sum_repeated_ids(111111, 111111) == 111111);
+static_assert(sum_repeated_ids(18446744073709551615u, 18446744073709551615u) == 0);
+
+template<std::uint64_t SumRange(std::uint64_t, std::uint64_t)>
+std::uint64_t sum_ranges(const std::vector<product_range> &ranges) {
+    std::uint64_t sum{0};
+    for (const auto [a, b]: ranges)
+        sum += SumRange(a, b);
+    return sum;
+}
+
+/// whether `id` is a block of `period` digits repeated to `length` digits, without converting it to a string.
+constexpr bool is_repeated(const std::uint64_t id, const int length, const int period) {
+    const auto r = repetition_factor(length, period);
+    return id % r == 0 && id / r < pow10(period);
+}
+
+/// part 1: an id is invalid if it consists of some digit sequence repeated exactly twice.
+constexpr bool id_is_valid_p1(const std::uint64_t id) {
+    const auto length = digit_count(id);
+    return length % 2 != 0 || !is_repeated(id, length, length / 2);
+}
+
+/// part 2: an id is invalid if it consists of some digit sequence repeated at least twice.
+constexpr bool id_is_valid_p2(const std::uint64_t id) {
+    const auto length = digit_count(id);
+    for (auto period{1}; period <= length / 2; ++period)
+        if (length % period == 0 && is_repeated(id, length, period)) return false;
+    return true;
+}
+
+static_assert(!id_is_valid_p1(123123) && id_is_valid_p1(111) && id_is_valid_p1(1231234));
+static_assert(!id_is_valid_p2(111) && !id_is_valid_p2(12121212) && id_is_valid_p2(1212121) && id_is_valid_p2(7));
+
+struct verification {
+    std::uint64_t sum;
+    std::uint64_t id_count;
+};
+
+/// brute force cross-check of the closed form. Every range is cut into chunks of at most `chunk` ids, which are
+/// checked id by id on all threads of the pool. The chunks aren't stored, a chunk's range is looked up from the first
+/// chunk index of every range.
+template<bool IdIsValid(std::uint64_t)>
+verification verify_invalid_ids(const std::vector<product_range> &ranges,
+                                util::thread_pool &pool = util::thread_pool::global(),
+                                const std::uint64_t chunk = 1 << 16) {
+    // range r has the chunks [first_chunk[r]; first_chunk[r + 1]).
+    std::vector<std::uint64_t> first_chunk{0};
+    first_chunk.reserve(ranges.size() + 1);
+    std::uint64_t id_count{0};
+    for (const auto [a, b]: ranges) {
+        if (a <= b) id_count += b - a + 1;
+        // written so that ranges ending at UINT64_MAX don't overflow.
+        first_chunk.push_back(first_chunk.back() + (a <= b ? (b - a) / chunk + 1 : 0));
+    }
+    const auto sum = util::parallel_reduce(
+            pool, std::uint64_t{0}, first_chunk.back(), std::uint64_t{0},
+            [&](const std::uint64_t c) {
+                const auto next = std::ranges::upper_bound(first_chunk, c);
+                const auto r = static_cast<std::size_t>(next - first_chunk.begin() - 1);
+                const auto [a, b] = ranges[r];
+                const auto from = a + (c - first_chunk[r]) * chunk;
+                const auto to = b - from < chunk ? b : from + chunk - 1;
+                std::uint64_t chunk_sum{0};
+                for (auto i{from};; ++i) {
+                    if (!IdIsValid(i)) chunk_sum += i;
+                    if (i == to) break;
+                }
+                return chunk_sum;
+            },
+            std::plus{}, 1);
+    return {.sum = sum, .id_count = id_count};
+}
+
+#endif // LIB02_HPP
@@ -1,25 +1,29 @@
+#include <chrono>
 #include <iostream>
-#include <fstream>
-#include <cstdint>
-#include <format>
+#include <string_view>
 
-bool id_is_valid(const std::string_view id) {
-    if (const auto l = id.length(); l % 2 == 0 && id.substr(0, l / 2) == id.substr(l / 2))
-        return false;
-    return true;
-}
+#include <input.hpp>
+
+#include "lib02.hpp"
+
+int main(const int argc, char **argv) {
+    // const util::mapped_file f{"../../d02/sample.txt"};
+    const util::mapped_file f{"../../d02/assignment.txt"};
+    const auto ranges = parse_product_ranges(f.view());
+    const auto result = sum_ranges<sum_doubled_ids>(ranges);
+    std::cout << "Result: " << result << std::endl;
 
-int main() {
-    // std::ifstream f{"../../d02/sample.txt"};
-    std::ifstream f{"../../d02/assignment.txt"};
-    std::uint64_t sum{0};
-    std::uint64_t a, b;
-    char dash, comma;
-    while (f >> a >> dash >> b) {
-        for (auto i{a}; i <= b; ++i)
-            if (!id_is_valid(std::to_string(i))) sum += i;
-        f >> comma;
+    // --verify checks every single id on all cores, to cross-check the closed form.
+    if (argc > 1 && std::string_view{argv[1]} == "--verify") {
+        const auto start = std::chrono::steady_clock::now();
+        const auto [sum, id_count] = verify_invalid_ids<id_is_valid_p1>(ranges);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Brute force: " << sum << " (" << id_count << " ids, " << id_count / elapsed.count()
+                  << " ids/s)" << std::endl;
+        if (sum != result) {
+            std::cout << "Mismatch!" << std::endl;
+            return 1;
+        }
     }
-    std::cout << "Result: " << sum << std::endl;
     return 0;
 }
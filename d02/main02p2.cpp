@@ -1,37 +1,29 @@
+#include <chrono>
 #include <iostream>
-#include <fstream>
-#include <cstdint>
-#include <format>
+#include <string_view>
 
-bool id_is_valid(const std::string_view id) {
-    const auto l = id.length();
-    if (l == 0) return false;
-    if (l == 1) return true;
-    if (l == 2) return id[0] != id[1];
-    if (l == 3) return id[0] != id[1] || id[0] != id[2];
-    for (auto test_length{1}; test_length <= l / 2; ++test_length) {
-        if (l % test_length != 0) continue;
-        const std::string_view first_segment = id.substr(0, test_length);
-        for (auto offset{test_length}; offset < l; offset += test_length)
-            if (first_segment != id.substr(offset, test_length))
-                goto outer;
-        return false;
-    outer:;
-    }
-    return true;
-}
+#include <input.hpp>
+
+#include "lib02.hpp"
+
+int main(const int argc, char **argv) {
+    // const util::mapped_file f{"../../d02/sample.txt"};
+    const util::mapped_file f{"../../d02/assignment.txt"};
+    const auto ranges = parse_product_ranges(f.view());
+    const auto result = sum_ranges<sum_repeated_ids>(ranges);
+    std::cout << "Result: " << result << std::endl;
 
-int main() {
-    // std::ifstream f{"../../d02/sample.txt"};
-    std::ifstream f{"../../d02/assignment.txt"};
-    std::uint64_t sum{0};
-    std::uint64_t a, b;
-    char dash, comma;
-    while (f >> a >> dash >> b) {
-        for (auto i{a}; i <= b; ++i)
-            if (!id_is_valid(std::to_string(i))) sum += i;
-        f >> comma;
+    // --verify checks every single id on all cores, to cross-check the closed form.
+    if (argc > 1 && std::string_view{argv[1]} == "--verify") {
+        const auto start = std::chrono::steady_clock::now();
+        const auto [sum, id_count] = verify_invalid_ids<id_is_valid_p2>(ranges);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Brute force: " << sum << " (" << id_count << " ids, " << id_count / elapsed.count()
+                  << " ids/s)" << std::endl;
+        if (sum != result) {
+            std::cout << "Mismatch!" << std::endl;
+            return 1;
+        }
     }
-    std::cout << "Result: " << sum << std::endl;
     return 0;
 }
@@ -0,0 +1,170 @@
+#ifndef LIB03_HPP
+#define LIB03_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <input.hpp>
+#include <parallel.hpp>
+
+inline std::vector<std::string_view> parse_banks(const std::string_view input) {
+    std::vector<std::string_view> banks{};
+    for (const auto line: util::lines{input})
+        if (!line.empty()) banks.push_back(line);
+    return banks;
+}
+
+/// unsigned decimal number of any length, for joltages with more digits than fit into 64 bits.
+class big_decimal {
+    static constexpr std::uint32_t limb_base{1'000'000'000};
+    static constexpr int limb_digits{9};
+    // least significant limb first, no leading zero limbs.
+    std::vector<std::uint32_t> limbs;
+
+public:
+    big_decimal() = default;
+
+    explicit big_decimal(std::uint64_t value) {
+        for (; value != 0; value /= limb_base)
+            limbs.push_back(static_cast<std::uint32_t>(value % limb_base));
+    }
+
+    explicit big_decimal(const std::string_view digits) {
+        for (auto end = static_cast<std::ptrdiff_t>(digits.size()); end > 0; end -= limb_digits) {
+            std::uint32_t limb{0};
+            for (auto i = std::max<std::ptrdiff_t>(0, end - limb_digits); i < end; ++i)
+                limb = limb * 10 + (digits[i] - '0');
+            limbs.push_back(limb);
+        }
+        while (!limbs.empty() && limbs.back() == 0)
+            limbs.pop_back();
+    }
+
+    big_decimal &operator+=(const big_decimal &other) {
+        if (limbs.size() < other.limbs.size()) limbs.resize(other.limbs.size());
+        std::uint32_t carry{0};
+        for (std::size_t i = 0; i < limbs.size(); ++i) {
+            const auto sum = limbs[i] + carry + (i < other.limbs.size() ? other.limbs[i] : 0);
+            carry = sum >= limb_base;
+            limbs[i] = carry ? sum - limb_base : sum;
+            if (!carry && i >= other.limbs.size()) break;
+        }
+        if (carry) limbs.push_back(carry);
+        return *this;
+    }
+
+    friend big_decimal operator+(big_decimal a, const big_decimal &b) { return a += b; }
+
+    [[nodiscard]] std::string to_string() const {
+        if (limbs.empty()) return "0";
+        auto result = std::format("{}", limbs.back());
+        for (auto it = limbs.rbegin() + 1; it != limbs.rend(); ++it)
+            std::format_to(std::back_inserter(result), "{:09}", *it);
+        return result;
+    }
+
+    bool operator==(const big_decimal &) const = default;
+};
+
+template<>
+struct std::formatter<big_decimal> : std::formatter<std::string> {
+    template<class FmtContext>
+    FmtContext::iterator format(const big_decimal &n, FmtContext &ctx) const {
+        return std::formatter<std::string>::format(n.to_string(), ctx);
+    }
+};
+
+/*
+ * Picking the largest k digits (in order) of a bank is greedy: a digit is worth more than every smaller digit before
+ * it, so it pops them off a stack of the digits chosen so far. That's only allowed while there are enough digits left
+ * to still end up with k of them. Every digit is pushed and popped at most once, so this is O(n) per bank, no matter
+ * how big k is.
+ */
+
+/// writes the largest `out.size()` digits of `bank` into `out`. Returns false if the bank has too few digits.
+inline bool select_digits(const std::string_view bank, const std::span<char> out) {
+    const auto k = out.size();
+    if (bank.size() < k) return false;
+    std::size_t size{0};
+    for (std::size_t i = 0; i < bank.size(); ++i) {
+        const char c = bank[i];
+        while (size != 0 && out[size - 1] < c && size + (bank.size() - i) > k)
+            --size;
+        if (size < k) out[size++] = c;
+    }
+    return true;
+}
+
+/// a single K-digit joltage fits into 64 bits up to 18 digits.
+template<std::size_t K>
+using joltage = std::conditional_t<K <= 18, std::uint64_t, big_decimal>;
+
+/// n K-digit joltages sum to less than n * 10^K, which fits into 64 bits for n < 1.8 * 10^(19 - K): over ten million
+/// banks at K = 12, but only about 1800 at K = 16 and fewer than 20 at K = 18, so totals from K = 16 on are big_decimal.
+template<std::size_t K>
+using joltage_total = std::conditional_t<K <= 15, std::uint64_t, big_decimal>;
+
+/// the largest K-digit joltage of a bank, or 0 if it has fewer than K batteries.
+template<std::size_t K>
+joltage<K> best_k_digits(const std::string_view bank) {
+    std::array<char, K> digits;
+    if (!select_digits(bank, digits)) return {};
+    if constexpr (K <= 18) {
+        std::uint64_t result{0};
+        for (const char c: digits)
+            result = result * 10 + (c - '0');
+        return result;
+    } else {
+        return big_decimal{std::string_view{digits.data(), K}};
+    }
+}
+
+/// runtime K variant of `best_k_digits`, always producing a big_decimal.
+inline big_decimal best_digits(const std::string_view bank, const std::size_t k) {
+    std::string digits(k, '0');
+    if (!select_digits(bank, digits)) return {};
+    return big_decimal{digits};
+}
+
+/// sum of the best K-digit joltages of every bank, with the banks spread over the shared pool.
+/// part 1 is K = 2, part 2 is K = 12.
+template<std::size_t K>
+joltage_total<K> total_joltage(const std::vector<std::string_view> &banks) {
+    return util::parallel_reduce(
+            std::size_t{0}, banks.size(), joltage_total<K>{},
+            [&](const std::size_t i) { return joltage_total<K>{best_k_digits<K>(banks[i])}; }, std::plus{});
+}
+
+inline big_decimal total_joltage(const std::vector<std::string_view> &banks, const std::size_t k) {
+    return util::parallel_reduce(
+            std::size_t{0}, banks.size(), big_decimal{}, [&](const std::size_t i) { return best_digits(banks[i], k); },
+            std::plus{});
+}
+
+/// `total_joltage<K>` straight from the raw input, for bank dumps too big to collect every line first. Every thread
+/// takes blocks of whole lines out of the input and scans them on its own.
+template<std::size_t K>
+joltage_total<K> total_joltage_streaming(const std::string_view input, const std::size_t block_size = 1 << 20) {
+    const auto blocks = util::line_blocks(input, block_size);
+    return util::parallel_reduce(
+            std::size_t{0}, blocks.size(), joltage_total<K>{},
+            [&](const std::size_t i) {
+                joltage_total<K> sum{};
+                for (const auto bank: util::lines{blocks[i]})
+                    if (!bank.empty()) sum += joltage_total<K>{best_k_digits<K>(bank)};
+                return sum;
+            },
+            std::plus{}, 1);
+}
+
+#endif // LIB03_HPP
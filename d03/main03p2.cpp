@@ -1,29 +1,29 @@
-#include <fstream>
+#include <charconv>
+#include <cstddef>
 #include <print>
+#include <string_view>
 
-long long pow10(const long long n) {
-    long long r = 1;
-    for (int i = 0; i < n; ++i)
-        r *= 10;
-    return r;
-}
+#include <input.hpp>
+
+#include "lib03.hpp"
+
+int main(const int argc, char **argv) {
+    // const util::mapped_file f{"../../d03/sample.txt"};
+    const util::mapped_file f{"../../d03/assignment.txt"};
+    const auto banks = parse_banks(f.view());
 
-int main() {
-    // std::ifstream f{"../../d03/sample.txt"};
-    std::ifstream f{"../../d03/assignment.txt"};
-    long long sum{0};
-    for (std::string line; std::getline(f, line);) {
-        const int len = static_cast<int>(line.length());
-        long long result = 0;
-        auto start_index = 0;
-        for (auto digit{11}; digit >= 0; --digit) {
-            const auto end_index = len - digit;
-            const auto max = std::max_element(line.begin() + start_index, line.begin() + end_index);
-            start_index = static_cast<int>(std::distance(line.begin(), max)) + 1;
-            result += (*max - '0') * pow10(digit);
+    // --digits K picks K batteries per bank instead of 12.
+    if (argc > 2 && std::string_view{argv[1]} == "--digits") {
+        const std::string_view value{argv[2]};
+        std::size_t k{};
+        if (const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), k);
+            ec != std::errc{} || ptr != value.data() + value.size()) {
+            std::println(stderr, "invalid digit count: {}", value);
+            return 1;
         }
-        sum += result;
+        std::println("Result: {}", total_joltage(banks, k));
+        return 0;
     }
-    std::println("Result: {}", sum);
+    std::println("Result: {}", total_joltage<12>(banks));
     return 0;
 }
@@ -0,0 +1,57 @@
+#include <chrono>
+#include <functional>
+#include <print>
+#include <string>
+
+#include "../gen/random.hpp"
+#include "hashlife.hpp"
+#include "lib04.hpp"
+
+using milliseconds = std::chrono::duration<double, std::milli>;
+
+/// a random `tile` x `tile` pattern, repeated `repeat` x `repeat` times.
+std::string repetitive_map(const int tile, const int repeat, const std::uint64_t seed) {
+    gen::random rng{seed};
+    std::vector<std::string> pattern(tile, std::string(tile, '.'));
+    for (auto &row: pattern)
+        for (auto &c: row)
+            c = rng.chance(0.65) ? paper_roll : '.';
+    std::string result{};
+    result.reserve(static_cast<std::size_t>(tile * repeat) * (tile * repeat + 1));
+    for (auto row{0}; row < tile * repeat; ++row) {
+        for (auto i{0}; i < repeat; ++i)
+            result += pattern[row % tile];
+        result += '\n';
+    }
+    return result;
+}
+
+template<typename F>
+std::pair<long long, milliseconds> measure(F &&f) {
+    const auto start = std::chrono::steady_clock::now();
+    const long long result = f();
+    return {result, std::chrono::steady_clock::now() - start};
+}
+
+/// compares the part 2 engines on repetitive maps of growing size, where the quadtree should pull ahead. Exits non-zero
+/// if they don't all remove the same amount of rolls.
+int main() {
+    constexpr int tile = 64;
+    std::println("{:>6} | {:>12} | {:>12} {:>12} {:>12}", "size", "removed", "sweep ms", "worklist ms",
+                 "hashlife ms");
+    auto disagreements{0};
+    for (const int repeat: {1, 4, 16, 64}) {
+        const auto map = repetitive_map(tile, repeat, 4);
+        const auto board = parse_grid(map);
+        const auto [sweep, sweep_time] = measure([&] { return count_removed(board); });
+        const auto [worklist, worklist_time] = measure([&] { return count_removed_incremental(board); });
+        const auto [hashlife, hashlife_time] = measure([&] { return count_removed_hashlife(board); });
+        if (sweep != worklist || sweep != hashlife) {
+            std::println(stderr, "engines disagree: {} {} {}", sweep, worklist, hashlife);
+            ++disagreements;
+        }
+        std::println("{:>6} | {:>12} | {:>12.3f} {:>12.3f} {:>12.3f}", tile * repeat, sweep, sweep_time.count(),
+                     worklist_time.count(), hashlife_time.count());
+    }
+    return disagreements != 0;
+}
@@ -0,0 +1,182 @@
+#ifndef HASHLIFE_HPP
+#define HASHLIFE_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "lib04.hpp"
+
+/*
+ * Part 2 as a cellular automaton: a roll stays if it has at least four neighboring rolls, everything else is empty in
+ * the next generation. Like Gosper's HashLife, the map is a quadtree whose nodes are hash-consed, so equal areas share
+ * one node no matter where (or how often) they appear. A node of 2^k x 2^k cells memoizes its center 2^(k-1) x 2^(k-1)
+ * cells 2^(k-2) generations later, which is computed from nine overlapping sub-results. Repetitive maps collapse into
+ * few distinct nodes, and each of them is only ever advanced once.
+ *
+ * Removing rolls never adds any, so the map reached its fixpoint as soon as advancing it doesn't change it, which for
+ * hash-consed nodes is a pointer comparison.
+ */
+
+class quadtree {
+public:
+    struct node {
+        const node *nw, *ne, *sw, *se;
+        int level;
+        long long population;
+        /// the center half, 2^(level - 2) generations later. Only for level >= 2, set once it has been computed.
+        mutable const node *result{nullptr};
+    };
+
+private:
+    struct children {
+        const node *nw, *ne, *sw, *se;
+
+        bool operator==(const children &) const = default;
+    };
+
+    struct children_hash {
+        std::size_t operator()(const children &c) const {
+            std::size_t h{0};
+            for (const node *n: {c.nw, c.ne, c.sw, c.se})
+                h = (h ^ std::hash<const node *>{}(n)) * 0x9e3779b97f4a7c15;
+            return h;
+        }
+    };
+
+    // a deque never moves its elements, so the nodes can point at each other.
+    std::deque<node> nodes;
+    std::unordered_map<children, const node *, children_hash> unique;
+    std::array<const node *, 2> leaves;
+    std::vector<const node *> empty_nodes;
+    std::unordered_map<std::uint64_t, const node *> blocks;
+
+    /// the center 2x2 cells of a 4x4 node, one generation later.
+    const node *step_base(const node *n) {
+        const auto cell = [&](const int x, const int y) -> int {
+            const node *quadrant = y < 2 ? (x < 2 ? n->nw : n->ne) : (x < 2 ? n->sw : n->se);
+            const node *leaf = y % 2 == 0 ? (x % 2 == 0 ? quadrant->nw : quadrant->ne)
+                                          : (x % 2 == 0 ? quadrant->sw : quadrant->se);
+            return static_cast<int>(leaf->population);
+        };
+        const auto next = [&](const int x, const int y) {
+            if (!cell(x, y)) return leaves[0];
+            auto neighbors{0};
+            for (auto dy{-1}; dy <= 1; ++dy)
+                for (auto dx{-1}; dx <= 1; ++dx)
+                    if (dx || dy) neighbors += cell(x + dx, y + dy);
+            return leaves[neighbors >= 4];
+        };
+        return join(next(1, 1), next(2, 1), next(1, 2), next(2, 2));
+    }
+
+    /// part of an 8x8 block, bit 8 y + x being the cell at (x, y).
+    const node *from_bits(const std::uint64_t bits, const int level, const int x, const int y) {
+        if (level == 0) return leaves[bits >> (8 * y + x) & 1];
+        const auto half = 1 << (level - 1);
+        return join(from_bits(bits, level - 1, x, y), from_bits(bits, level - 1, x + half, y),
+                    from_bits(bits, level - 1, x, y + half), from_bits(bits, level - 1, x + half, y + half));
+    }
+
+    const node *build(const bitboard &board, const int level, const int x, const int y) {
+        if (x >= board.width || y >= board.height) return empty(level);
+        if (level == 3) {
+            // 8x8 blocks are read as a whole, and only turned into nodes the first time a pattern shows up.
+            std::uint64_t bits{0};
+            for (auto row{0}; row < 8; ++row)
+                bits |= (board.word(y + row, x / 64) >> (x % 64) & 0xff) << (8 * row);
+            auto &block = blocks[bits];
+            if (!block) block = from_bits(bits, 3, 0, 0);
+            return block;
+        }
+        const auto half = 1 << (level - 1);
+        return join(build(board, level - 1, x, y), build(board, level - 1, x + half, y),
+                    build(board, level - 1, x, y + half), build(board, level - 1, x + half, y + half));
+    }
+
+public:
+    quadtree() {
+        leaves = {&nodes.emplace_back(nullptr, nullptr, nullptr, nullptr, 0, 0),
+                  &nodes.emplace_back(nullptr, nullptr, nullptr, nullptr, 0, 1)};
+        empty_nodes.push_back(leaves[0]);
+    }
+
+    quadtree(const quadtree &) = delete;
+    quadtree &operator=(const quadtree &) = delete;
+
+    [[nodiscard]] std::size_t node_count() const { return nodes.size(); }
+
+    const node *join(const node *nw, const node *ne, const node *sw, const node *se) {
+        const children key{nw, ne, sw, se};
+        if (const auto it = unique.find(key); it != unique.end()) return it->second;
+        const node *n = &nodes.emplace_back(nw, ne, sw, se, nw->level + 1,
+                                            nw->population + ne->population + sw->population + se->population);
+        unique.emplace(key, n);
+        return n;
+    }
+
+    const node *empty(const int level) {
+        while (empty_nodes.size() <= static_cast<std::size_t>(level)) {
+            const auto *e = empty_nodes.back();
+            empty_nodes.push_back(join(e, e, e, e));
+        }
+        return empty_nodes[level];
+    }
+
+    /// the smallest node (at least 8x8) covering the board, which sits in its top left corner.
+    const node *build(const bitboard &board) {
+        const auto size = static_cast<unsigned>(std::max({board.width, board.height, 8}));
+        return build(board, std::bit_width(std::bit_ceil(size)) - 1, 0, 0);
+    }
+
+    /// the same area, surrounded by empty cells, one level up.
+    const node *expand(const node *n) {
+        const auto *e = empty(n->level - 1);
+        return join(join(e, e, e, n->nw), join(e, e, n->ne, e), join(e, n->sw, e, e), join(n->se, e, e, e));
+    }
+
+    /// the center half of a node of level >= 2, 2^(level - 2) generations later.
+    const node *step(const node *n) {
+        if (n->result) return n->result;
+        if (n->population == 0) return n->result = empty(n->level - 1);
+        if (n->level == 2) return n->result = step_base(n);
+        const auto *nw = n->nw, *ne = n->ne, *sw = n->sw, *se = n->se;
+        // nine overlapping nodes one level down, each advanced by a quarter of the generations...
+        const auto *r00 = step(nw);
+        const auto *r01 = step(join(nw->ne, ne->nw, nw->se, ne->sw));
+        const auto *r02 = step(ne);
+        const auto *r10 = step(join(nw->sw, nw->se, sw->nw, sw->ne));
+        const auto *r11 = step(join(nw->se, ne->sw, sw->ne, se->nw));
+        const auto *r12 = step(join(ne->sw, ne->se, se->nw, se->ne));
+        const auto *r20 = step(sw);
+        const auto *r21 = step(join(sw->ne, se->nw, sw->se, se->sw));
+        const auto *r22 = step(se);
+        // ...combined into four, which are advanced by the other quarter.
+        return n->result = join(step(join(r00, r01, r10, r11)), step(join(r01, r02, r11, r12)),
+                                step(join(r10, r11, r20, r21)), step(join(r11, r12, r21, r22)));
+    }
+
+    /// advances the map until nothing changes anymore.
+    const node *fixpoint(const node *root) {
+        while (true) {
+            const auto *next = step(expand(root));
+            if (next == root) return root;
+            root = next;
+        }
+    }
+};
+
+/// part 2 on the memoized quadtree. Pays off for big maps consisting of repeated patterns.
+inline long long count_removed_hashlife(const bitboard &board) {
+    quadtree tree{};
+    const auto *root = tree.build(board);
+    return root->population - tree.fixpoint(root)->population;
+}
+
+#endif // HASHLIFE_HPP
@@ -0,0 +1,287 @@
+#ifndef LIB04_HPP
+#define LIB04_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <input.hpp>
+#include <parallel.hpp>
+#include <scratch.hpp>
+
+static constexpr char paper_roll = '@';
+
+/// one bit per cell, set for paper rolls. Every row is padded to whole 64-bit words, bit i of word w being column
+/// 64 w + i. The padding bits are always zero.
+struct bitboard {
+    int width{0};
+    int height{0};
+    int words_per_row{0};
+    std::vector<std::uint64_t> words;
+
+    [[nodiscard]] std::uint64_t word(const int row, const int w) const {
+        if (row < 0 || row >= height || w < 0 || w >= words_per_row) return 0;
+        return words[static_cast<std::size_t>(row) * words_per_row + w];
+    }
+
+    [[nodiscard]] bool get(const int row, const int col) const {
+        if (col < 0 || col >= width) return false;
+        return word(row, col / 64) >> (col % 64) & 1;
+    }
+
+    void set(const int row, const int col) {
+        words[static_cast<std::size_t>(row) * words_per_row + col / 64] |= std::uint64_t{1} << (col % 64);
+    }
+
+    [[nodiscard]] long long count() const {
+        long long result{0};
+        for (const auto w: words)
+            result += std::popcount(w);
+        return result;
+    }
+};
+
+inline bitboard parse_grid(const std::string_view input) {
+    const util::lines lines{input};
+    bitboard result{};
+    for (const auto line: lines) {
+        result.width = std::max(result.width, static_cast<int>(line.length()));
+        ++result.height;
+    }
+    result.words_per_row = (result.width + 63) / 64;
+    result.words.resize(static_cast<std::size_t>(result.height) * result.words_per_row);
+    auto row{0};
+    for (const auto line: lines) {
+        for (std::size_t col = 0; col < line.length(); ++col)
+            if (line[col] == paper_roll) result.set(row, static_cast<int>(col));
+        ++row;
+    }
+    return result;
+}
+
+/*
+ * Instead of counting the eight neighbors of every cell one by one, the neighbors of 64 cells are counted at once:
+ * shifting a row's words by one column gives the west and east neighbors of all of its cells, so a word of cells has
+ * eight neighbor words. These are added up bit-sliced, i.e. every bit position is its own little counter, spread over
+ * three words for the counter bits 1, 2 and 4 (saturating at 4, as more isn't needed).
+ */
+
+/// the bits of `center` (and its neighboring words `west`/`east` in the same row) shifted by one column each way.
+struct row_neighbors {
+    std::uint64_t west;
+    std::uint64_t center;
+    std::uint64_t east;
+
+    row_neighbors(const std::uint64_t previous, const std::uint64_t center, const std::uint64_t next) :
+        west{center << 1 | previous >> 63}, center{center}, east{center >> 1 | next << 63} {}
+};
+
+/// bit-sliced counter of up to three (and "four or more") set bits per bit position.
+struct neighbor_counter {
+    std::uint64_t ones{0};
+    std::uint64_t twos{0};
+    std::uint64_t four_or_more{0};
+
+    void add(const std::uint64_t x) {
+        const auto carry_ones = ones & x;
+        ones ^= x;
+        const auto carry_twos = twos & carry_ones;
+        twos ^= carry_ones;
+        four_or_more |= carry_twos;
+    }
+};
+
+/// the bits of word `w` in `row` whose cells have fewer than four neighboring rolls.
+inline std::uint64_t fewer_than_four(const bitboard &board, const int row, const int w) {
+    const row_neighbors above{board.word(row - 1, w - 1), board.word(row - 1, w), board.word(row - 1, w + 1)};
+    const row_neighbors same{board.word(row, w - 1), board.word(row, w), board.word(row, w + 1)};
+    const row_neighbors below{board.word(row + 1, w - 1), board.word(row + 1, w), board.word(row + 1, w + 1)};
+    neighbor_counter counter{};
+    counter.add(above.west);
+    counter.add(above.center);
+    counter.add(above.east);
+    counter.add(same.west);
+    counter.add(same.east);
+    counter.add(below.west);
+    counter.add(below.center);
+    counter.add(below.east);
+    return ~counter.four_or_more;
+}
+
+/// writes the rolls which have fewer than four neighboring rolls into `result`, which has the shape of `board`.
+inline void accessible(const bitboard &board, bitboard &result) {
+    for (auto row{0}; row < board.height; ++row)
+        for (auto w{0}; w < board.words_per_row; ++w)
+            result.words[static_cast<std::size_t>(row) * board.words_per_row + w] =
+                    board.word(row, w) & fewer_than_four(board, row, w);
+}
+
+/// the rolls which have fewer than four neighboring rolls, i.e. which the forklifts can access.
+inline bitboard accessible(const bitboard &board) {
+    bitboard result{board.width, board.height, board.words_per_row, std::vector<std::uint64_t>(board.words.size())};
+    accessible(board, result);
+    return result;
+}
+
+/// part 1: the rolls with fewer than four neighbors.
+inline long long count_accessible(const bitboard &board) { return accessible(board).count(); }
+
+/// part 2: keeps removing every accessible roll at once, until none is left. Removing rolls only makes others more
+/// accessible, so the order of removal doesn't change which rolls end up removed.
+inline long long count_removed(bitboard board) {
+    long long removed_count{0};
+    while (true) {
+        const auto removable = accessible(board);
+        const auto count = removable.count();
+        if (count == 0) break;
+        removed_count += count;
+        for (std::size_t i = 0; i < board.words.size(); ++i)
+            board.words[i] &= ~removable.words[i];
+    }
+    return removed_count;
+}
+
+/// part 2, doing O(cells) work no matter how many rounds the peeling takes: every roll keeps its amount of neighboring
+/// rolls, and removing a roll only looks at its eight neighbors again. Those that drop below four neighbors right then
+/// are queued for removal.
+inline long long count_removed_incremental(const bitboard &board) {
+    // one cell of padding around the grid, so neighbors never need bounds checks.
+    const auto stride = static_cast<std::size_t>(board.width) + 2;
+    const std::array<std::ptrdiff_t, 8> offsets{
+            -static_cast<std::ptrdiff_t>(stride) - 1, -static_cast<std::ptrdiff_t>(stride),
+            -static_cast<std::ptrdiff_t>(stride) + 1, -1, 1, static_cast<std::ptrdiff_t>(stride) - 1,
+            static_cast<std::ptrdiff_t>(stride), static_cast<std::ptrdiff_t>(stride) + 1};
+    std::vector<std::uint8_t> is_roll(stride * (board.height + 2));
+    for (auto row{0}; row < board.height; ++row)
+        for (auto col{0}; col < board.width; ++col)
+            is_roll[(row + 1) * stride + col + 1] = board.get(row, col);
+
+    std::vector<std::uint8_t> neighbors(is_roll.size());
+    std::vector<std::size_t> queue{};
+    for (std::size_t i = stride; i < is_roll.size() - stride; ++i) {
+        if (!is_roll[i]) continue;
+        for (const auto offset: offsets)
+            neighbors[i] += is_roll[i + offset];
+        if (neighbors[i] < 4) queue.push_back(i);
+    }
+
+    long long removed_count{0};
+    while (!queue.empty()) {
+        const auto i = queue.back();
+        queue.pop_back();
+        is_roll[i] = false;
+        ++removed_count;
+        for (const auto offset: offsets) {
+            const auto n = i + offset;
+            // a neighbor dropping from 4 to 3 just became accessible, any lower and it's already queued.
+            if (is_roll[n] && neighbors[n]-- == 4) queue.push_back(n);
+        }
+    }
+    return removed_count;
+}
+
+/*
+ * Out-of-core part 2, for maps that don't fit into memory as a whole. The input stays memory-mapped, and the roll bits
+ * live in a scratch file which the kernel can page out. The rows are cut into bands, and each band is peeled to its
+ * own fixpoint in a small buffer, with the rows directly above and below as a frozen halo. Removing rolls from a band's
+ * first or last row changes the halo of the neighboring band, which then has to be peeled again. Once no band is left
+ * to peel, the whole map is at its fixpoint, which is the same as peeling it at once, as the order of removal doesn't
+ * matter.
+ *
+ * Bands are peeled in two alternating phases, first the even and then the odd ones, so no band is written while a
+ * neighbor reads it as its halo. Within a phase, the bands are spread over the thread pool.
+ */
+
+/// removed rolls of a band, and whether its first/last row changed.
+struct band_result {
+    long long removed_count;
+    bool first_changed;
+    bool last_changed;
+};
+
+/// peels rows [first_row; last_row) of `state` to a fixpoint, given the rows around them.
+inline band_result peel_band(const std::span<std::uint64_t> state, const int width, const int height,
+                             const int first_row, const int last_row) {
+    const auto words_per_row = (width + 63) / 64;
+    const auto rows = last_row - first_row;
+    // rows + 2 halo rows, which are zero outside of the map.
+    bitboard band{width, rows + 2, words_per_row,
+                  std::vector<std::uint64_t>(static_cast<std::size_t>(rows + 2) * words_per_row)};
+    for (auto row{first_row - 1}; row <= last_row; ++row)
+        if (row >= 0 && row < height)
+            std::ranges::copy(state.subspan(static_cast<std::size_t>(row) * words_per_row, words_per_row),
+                              band.words.begin() + static_cast<std::ptrdiff_t>(row - first_row + 1) * words_per_row);
+
+    // every round overwrites all of it, so it's allocated once.
+    bitboard removable{band.width, band.height, words_per_row, std::vector<std::uint64_t>(band.words.size())};
+    band_result result{};
+    while (true) {
+        accessible(band, removable);
+        // the halo is only read, the neighboring bands take care of it.
+        std::ranges::fill_n(removable.words.begin(), words_per_row, 0);
+        std::ranges::fill_n(removable.words.end() - words_per_row, words_per_row, 0);
+        const auto count = removable.count();
+        if (count == 0) break;
+        result.removed_count += count;
+        for (auto w{0}; w < words_per_row; ++w) {
+            result.first_changed |= removable.word(1, w) != 0;
+            result.last_changed |= removable.word(rows, w) != 0;
+        }
+        for (std::size_t i = 0; i < band.words.size(); ++i)
+            band.words[i] &= ~removable.words[i];
+    }
+    std::ranges::copy(std::span{band.words}.subspan(words_per_row, static_cast<std::size_t>(rows) * words_per_row),
+                      state.begin() + static_cast<std::ptrdiff_t>(first_row) * words_per_row);
+    return result;
+}
+
+/// part 2 straight from the (mapped) input, keeping only `band_rows` rows per thread in memory.
+inline long long count_removed_out_of_core(const std::string_view input, const int band_rows = 256) {
+    const util::lines lines{input};
+    auto width{0}, height{0};
+    for (const auto line: lines) {
+        width = std::max(width, static_cast<int>(line.length()));
+        ++height;
+    }
+    const auto words_per_row = (width + 63) / 64;
+    const util::scratch_array<std::uint64_t> state{static_cast<std::size_t>(height) * words_per_row};
+    auto row{0};
+    for (const auto line: lines) {
+        for (std::size_t col = 0; col < line.length(); ++col)
+            if (line[col] == paper_roll)
+                state[static_cast<std::size_t>(row) * words_per_row + col / 64] |= std::uint64_t{1} << (col % 64);
+        ++row;
+    }
+
+    const auto band_count = (height + band_rows - 1) / band_rows;
+    std::vector<std::atomic<bool>> dirty(band_count);
+    for (auto &d: dirty)
+        d.store(true, std::memory_order_relaxed);
+    std::atomic<long long> removed_count{0};
+    do {
+        for (auto parity{0}; parity < 2; ++parity) {
+            util::parallel_for(
+                    0, (band_count - parity + 1) / 2,
+                    [&](const int i) {
+                        const auto band = 2 * i + parity;
+                        if (!dirty[band].exchange(false, std::memory_order_relaxed)) return;
+                        const auto [removed, first_changed, last_changed] =
+                                peel_band(state.span(), width, height, band * band_rows,
+                                          std::min(height, (band + 1) * band_rows));
+                        removed_count.fetch_add(removed, std::memory_order_relaxed);
+                        if (first_changed && band > 0) dirty[band - 1].store(true, std::memory_order_relaxed);
+                        if (last_changed && band + 1 < band_count) dirty[band + 1].store(true, std::memory_order_relaxed);
+                    },
+                    1);
+        }
+    } while (std::ranges::any_of(dirty, [](const auto &d) { return d.load(std::memory_order_relaxed); }));
+    return removed_count.load();
+}
+
+#endif // LIB04_HPP
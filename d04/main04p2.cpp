@@ -1,68 +1,24 @@
-#include <fstream>
 #include <print>
-#include <string>
-#include <vector>
+#include <string_view>
 
-static constexpr char paper_roll = '@';
+#include <input.hpp>
 
-struct grid_struct {
-    int width;
-    int height;
-    std::vector<bool> data;
+#include "hashlife.hpp"
+#include "lib04.hpp"
 
-    void set(const int row, const int col, const int val) {
-        if (row < 0 || row >= height || col < 0 || col >= width) throw std::out_of_range("index out of range");
-        data.at(row * width + col) = val;
+int main(const int argc, char **argv) {
+    // const util::mapped_file f{"../../d04/sample.txt"};
+    const util::mapped_file f{"../../d04/assignment.txt"};
+    // --out-of-core never holds the whole map in memory, for maps bigger than the RAM.
+    if (argc > 1 && std::string_view{argv[1]} == "--out-of-core") {
+        std::println("Removed {} rolls.", count_removed_out_of_core(f.view()));
+        return 0;
     }
-
-    [[nodiscard]] bool get(const int row, const int col) const {
-        if (row < 0 || row >= height || col < 0 || col >= width) return false;
-        return data[row * width + col];
-    }
-};
-
-grid_struct parse(std::istream &f) {
-    grid_struct result{.width = -1};
-    std::string line;
-    while (std::getline(f, line)) {
-        if (result.width == -1) result.width = static_cast<int>(line.length());
-        for (const char c: line)
-            result.data.push_back(c == paper_roll);
-    }
-    result.height = static_cast<int>(result.data.size() / result.width);
-    return result;
-}
-
-int neighbor_count(const grid_struct &grid, int row, int col) {
-    auto count{0};
-    for (auto row_off{-1}; row_off <= 1; ++row_off) {
-        for (auto col_off{-1}; col_off <= 1; ++col_off) {
-            if (!row_off && !col_off) continue;
-            if (grid.get(row + row_off, col + col_off)) ++count;
-        }
-    }
-    return count;
-}
-
-int main() {
-    // std::ifstream f{"../../d04/sample.txt"};
-    std::ifstream f{"../../d04/assignment.txt"};
-    grid_struct grid = parse(f);
-    bool changed{true};
-    auto removed_count{0};
-    while (changed) {
-        changed = false;
-        for (auto row{0}; row < grid.height; ++row) {
-            for (auto col{0}; col < grid.width; ++col) {
-                if (!grid.get(row, col)) continue;
-                if (neighbor_count(grid, row, col) < 4) {
-                    changed = true;
-                    grid.set(row, col, false);
-                    ++removed_count;
-                }
-            }
-        }
+    // --hashlife runs the memoized quadtree, which is faster for huge maps made of repeated patterns.
+    if (argc > 1 && std::string_view{argv[1]} == "--hashlife") {
+        std::println("Removed {} rolls.", count_removed_hashlife(parse_grid(f.view())));
+        return 0;
     }
-    std::println("Removed {} rolls.", removed_count);
+    std::println("Removed {} rolls.", count_removed_incremental(parse_grid(f.view())));
     return 0;
 }
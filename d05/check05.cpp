@@ -0,0 +1,57 @@
+#include <climits>
+#include <cstdint>
+#include <print>
+#include <string_view>
+#include <vector>
+
+#include "lib06.hpp"
+
+int failure_count{0};
+
+void check(const bool ok, const std::string_view what) {
+    if (ok) return;
+    std::println(stderr, "failed: {}", what);
+    ++failure_count;
+}
+
+/// merging of overlapping, adjacent and nested ranges in `interval_set`, splitting by erase, and both at the ends of
+/// long long. Exits non-zero if any check fails.
+int main() {
+    interval_set set{};
+    set.insert({3, 5});
+    set.insert({7, 9});
+    check(set.size() == 2 && set.covered() == 6, "disjoint ranges stay apart");
+    set.insert({6, 6});
+    check(set.size() == 1 && set.covered() == 7 && set.contains(6), "a range adjacent on both sides merges all three");
+    set.insert({1, 4});
+    check(set.merged() == std::vector<id_range>{{1, 9}} && set.covered() == 9, "an overlapping range merges");
+    set.erase({5, 6});
+    check(set.merged() == std::vector<id_range>{{1, 4}, {7, 9}} && set.covered() == 7 && !set.contains(5),
+          "erasing the middle splits a range");
+    set.erase({0, 1});
+    set.erase({9, 20});
+    check(set.merged() == std::vector<id_range>{{2, 4}, {7, 8}} && set.covered() == 5,
+          "erasing over either end trims a range");
+
+    set.insert({LLONG_MAX - 1, LLONG_MAX});
+    set.insert({LLONG_MAX - 3, LLONG_MAX - 2});
+    set.insert({LLONG_MIN + 1, LLONG_MIN + 1});
+    set.insert({LLONG_MIN, LLONG_MIN});
+    check(set.size() == 4 && set.covered() == 11 && set.contains(LLONG_MAX) && set.contains(LLONG_MIN),
+          "adjacent ranges merge at the ends of long long");
+    set.erase({LLONG_MAX, LLONG_MAX});
+    set.erase({LLONG_MIN, LLONG_MIN});
+    check(set.merged() == std::vector<id_range>{{LLONG_MIN + 1, LLONG_MIN + 1}, {2, 4}, {7, 8},
+                                                {LLONG_MAX - 3, LLONG_MAX - 1}},
+          "erasing splits at the ends of long long");
+    set.insert({0, LLONG_MAX});
+    check(set.size() == 2 && set.covered() == std::uint64_t{LLONG_MAX} + 2, "the covered count exceeds a long long");
+    set.erase({LLONG_MIN, LLONG_MAX});
+    check(set.size() == 0 && set.covered() == 0, "erasing everything");
+
+    const std::vector<id_range> nested{{1, 10}, {2, 3}, {5, 6}};
+    check(interval_set{nested}.merged() == merge_ranges(nested), "nested ranges merge like merge_ranges");
+
+    if (failure_count == 0) std::println("All checks passed.");
+    return failure_count != 0;
+}
@@ -2,38 +2,450 @@
 #define LIB06_HPP
 
 #include <algorithm>
-#include <fstream>
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <queue>
 #include <ranges>
-#include <sstream>
-#include <string>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
+#include <input.hpp>
+#include <parallel.hpp>
+
 using id_range = std::pair<long long, long long>;
 
-inline std::vector<id_range> parse_ranges(std::istream &f) {
+/// a single "from-to" line.
+inline id_range parse_range(const std::string_view line) {
+    util::scanner ls{line};
+    long long from, to;
+    char dash;
+    ls.read(from);
+    ls.read(dash);
+    ls.read(to);
+    return {from, to};
+}
+
+/// sorts the ranges and merges overlapping or adjacent ones. Every range is compared with the end of everything merged
+/// so far rather than with its neighbor, as one long range can swallow several shorter ones after it.
+constexpr std::vector<id_range> merge_ranges(std::vector<id_range> ranges) {
+    std::ranges::sort(ranges);
+    std::vector<id_range> merged;
+    for (const auto range: ranges) {
+        if (!merged.empty() && range.first <= merged.back().second + 1)
+            merged.back().second = std::max(merged.back().second, range.second);
+        else
+            merged.push_back(range);
+    }
+    return merged;
+}
+
+static_assert(merge_ranges({{5, 6}, {1, 3}, {4, 4}}) == std::vector<id_range>{{1, 6}});
+static_assert(merge_ranges({{1, 2}, {4, 5}}) == std::vector<id_range>{{1, 2}, {4, 5}});
+// nested ranges: 5-6 doesn't touch 2-3, but both lie inside 1-10.
+static_assert(merge_ranges({{1, 10}, {2, 3}, {5, 6}}) == std::vector<id_range>{{1, 10}});
+
+/// reads range lines up to (and including) the first empty line, and merges overlapping or adjacent ranges.
+inline std::vector<id_range> read_ranges(util::scanner &s) {
     std::vector<id_range> ranges;
-    std::string line;
-    while (std::getline(f, line)) {
+    for (std::string_view line; s.read_line(line);) {
         if (line.empty()) break;
-        std::stringstream ss{line};
-        long long from, to;
-        char dash;
-        ss >> from >> dash >> to;
-        ranges.emplace_back(from, to);
+        ranges.push_back(parse_range(line));
     }
-    std::ranges::sort(ranges);
-    return ranges |
-           std::ranges::views::chunk_by([](const id_range &a, const id_range &b) { return b.first <= a.second + 1; }) |
-           std::ranges::views::transform([](auto &&window) {
-               return id_range{std::ranges::min(window, {}, [](const id_range &range) { return range.first; }).first,
-                               std::ranges::max(window, {}, [](const id_range &range) { return range.second; }).second};
-           }) |
-           std::ranges::to<std::vector>();
+    return merge_ranges(std::move(ranges));
+}
+
+inline std::vector<id_range> parse_ranges(const std::string_view input) {
+    util::scanner s{input};
+    return read_ranges(s);
 }
 
 inline bool includes_id(const std::vector<id_range> &ranges, const long long id) {
     return std::ranges::any_of(ranges, [id](const auto &range) { return id >= range.first && id <= range.second; });
 }
 
+/*
+ * The merged ranges are disjoint and sorted, so an id is fresh iff the first range ending at or after it also starts at
+ * or before it. That range is found by a binary search over the ends, laid out in Eytzinger order (the implicit binary
+ * tree in breadth-first order, children of k at 2k and 2k + 1). The top levels of the tree share a few cache lines,
+ * and the search is a fixed amount of branchless steps. The tree is padded to a perfect one, so every search takes
+ * exactly `depth` steps, which is what lets several of them run interleaved. The padding is empty (starting at
+ * LLONG_MAX) and ends where the last range does: the ends stay sorted, and as the last range comes before it, a search
+ * never ends up on the padding, not even for LLONG_MAX.
+ */
+class range_index {
+    // slot 0 is an empty range, which is where a search ends up if no range ends at or after the id.
+    std::vector<long long> starts{1};
+    std::vector<long long> ends{0};
+    int depth{0};
+
+    /// Eytzinger slot of the first range ending at or after `id`, given the slot after `depth` steps.
+    static std::size_t slot(const std::size_t k) { return k >> (std::countr_one(k) + 1); }
+
+    [[nodiscard]] bool fresh_at(const std::size_t k, const long long id) const {
+        return starts[k] <= id && id <= ends[k];
+    }
+
+    /// an in-order walk of the implicit tree visits the slots in sorted order.
+    void fill(const std::vector<id_range> &merged, std::size_t &i, const std::size_t k) {
+        if (k >= starts.size()) return;
+        fill(merged, i, 2 * k);
+        if (i < merged.size()) std::tie(starts[k], ends[k]) = merged[i++];
+        fill(merged, i, 2 * k + 1);
+    }
+
+public:
+    /// interleaved searches per thread, enough to keep several cache misses in flight.
+    static constexpr std::size_t lanes{8};
+
+    explicit range_index(const std::vector<id_range> &merged) {
+        depth = std::bit_width(merged.size());
+        const auto size = (std::size_t{1} << depth) - 1;
+        starts.resize(size + 1, LLONG_MAX);
+        ends.resize(size + 1, merged.empty() ? LLONG_MIN : merged.back().second);
+        std::size_t i{0};
+        fill(merged, i, 1);
+    }
+
+    [[nodiscard]] bool contains(const long long id) const {
+        std::size_t k{1};
+        for (auto level{0}; level < depth; ++level)
+            k = 2 * k + (ends[k] < id);
+        return fresh_at(slot(k), id);
+    }
+
+    /// calls `f(i, fresh)` for every id, searching for `lanes` ids at a time.
+    template<typename F>
+    void classify(const std::span<const long long> ids, F &&f) const {
+        std::size_t i{0};
+        for (; i + lanes <= ids.size(); i += lanes) {
+            std::array<std::size_t, lanes> k;
+            k.fill(1);
+            for (auto level{0}; level < depth; ++level)
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                    k[lane] = 2 * k[lane] + (ends[k[lane]] < ids[i + lane]);
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+                f(i + lane, fresh_at(slot(k[lane]), ids[i + lane]));
+        }
+        for (; i < ids.size(); ++i)
+            f(i, contains(ids[i]));
+    }
+
+    /// how many of the ids are fresh, with the ids spread over the shared pool.
+    [[nodiscard]] long long count(const std::span<const long long> ids) const {
+        constexpr std::size_t chunk{1 << 14};
+        return util::parallel_reduce(
+                std::size_t{0}, (ids.size() + chunk - 1) / chunk, 0ll,
+                [&](const std::size_t c) {
+                    long long fresh_count{0};
+                    classify(ids.subspan(c * chunk, std::min(chunk, ids.size() - c * chunk)),
+                             [&](std::size_t, const bool fresh) { fresh_count += fresh; });
+                    return fresh_count;
+                },
+                std::plus{}, 1);
+    }
+};
+
+/// ranges which can be added and removed one by one, for a database that changes over time. The stored ranges are
+/// always merged, so the amount of covered ids (part 2) is kept up to date instead of being recounted. Every insert and
+/// erase is O(log n), plus the ranges it merges or cuts, each of which is only removed once after being added.
+class interval_set {
+    // start -> end, disjoint and not adjacent.
+    std::map<long long, long long> ranges;
+    std::uint64_t covered_count{0};
+
+    /// ids in [from; to], which is only short of the true count when all 2^64 ids are covered.
+    static std::uint64_t length(const long long from, const long long to) {
+        return static_cast<std::uint64_t>(to) - static_cast<std::uint64_t>(from) + 1;
+    }
+
+public:
+    interval_set() = default;
+
+    explicit interval_set(const std::vector<id_range> &ranges) {
+        for (const auto &range: ranges)
+            insert(range);
+    }
+
+    void insert(id_range range) {
+        auto [first, last] = range;
+        auto it = ranges.upper_bound(first);
+        // the comparisons are written so that ranges at either end of long long don't overflow.
+        if (it != ranges.begin() && (first == LLONG_MIN || std::prev(it)->second >= first - 1)) first = (--it)->first;
+        while (it != ranges.end() && (last == LLONG_MAX || it->first <= last + 1)) {
+            last = std::max(last, it->second);
+            covered_count -= length(it->first, it->second);
+            it = ranges.erase(it);
+        }
+        ranges.emplace_hint(it, first, last);
+        covered_count += length(first, last);
+    }
+
+    void erase(const id_range range) {
+        const auto [first, last] = range;
+        auto it = ranges.upper_bound(first);
+        if (it != ranges.begin() && std::prev(it)->second >= first) --it;
+        while (it != ranges.end() && it->first <= last) {
+            const auto [from, to] = *it;
+            covered_count -= length(from, to);
+            it = ranges.erase(it);
+            // whatever sticks out on either side stays.
+            if (from < first) {
+                ranges.emplace_hint(it, from, first - 1);
+                covered_count += length(from, first - 1);
+            }
+            if (to > last) {
+                it = std::next(ranges.emplace_hint(it, last + 1, to));
+                covered_count += length(last + 1, to);
+            }
+        }
+    }
+
+    [[nodiscard]] bool contains(const long long id) const {
+        const auto it = ranges.upper_bound(id);
+        return it != ranges.begin() && std::prev(it)->second >= id;
+    }
+
+    /// how many ids are covered, i.e. part 2.
+    [[nodiscard]] std::uint64_t covered() const { return covered_count; }
+
+    /// amount of (merged) ranges.
+    [[nodiscard]] std::size_t size() const { return ranges.size(); }
+
+    /// the merged ranges in order, the same as `merge_ranges` of everything inserted minus everything erased.
+    [[nodiscard]] std::vector<id_range> merged() const { return {ranges.begin(), ranges.end()}; }
+};
+
+/// part 2, inserting the ranges into an `interval_set` one by one as they are read, without sorting them first.
+inline std::uint64_t count_fresh_ids_incremental(const std::string_view input) {
+    util::scanner s{input};
+    interval_set set{};
+    for (std::string_view line; s.read_line(line);) {
+        if (line.empty()) break;
+        set.insert(parse_range(line));
+    }
+    return set.covered();
+}
+
+/*
+ * External-memory merging, for range lists that don't fit into memory. The ranges are read in runs as big as the
+ * memory budget allows, and every run is sorted, merged and written to a temporary file. Those runs are then merged
+ * k-way, reading each through its own share of the budget, and the ranges are merged once more as they come out in
+ * order. The input itself stays memory-mapped, which the kernel pages in and out as needed.
+ *
+ * Every run holds a file open and needs a read buffer, so no more than `fan_in` runs are merged at once. Once that
+ * many runs of the same level pile up, they are merged into one run of the next level, as in a multi-pass merge sort.
+ * That keeps the amount of open files logarithmic in the input, and every merge (and every run's read buffer) lives
+ * in the same scratch memory that the ranges are read into.
+ */
+
+/// a range as it's stored in a run file.
+struct stored_range {
+    long long first;
+    long long last;
+};
+
+/// sorts the ranges and merges overlapping or adjacent ones, in place.
+inline void merge_in_place(std::vector<stored_range> &ranges) {
+    std::ranges::sort(ranges, {}, &stored_range::first);
+    std::size_t size{0};
+    for (const auto range: ranges) {
+        if (size != 0 && range.first <= ranges[size - 1].last + 1)
+            ranges[size - 1].last = std::max(ranges[size - 1].last, range.last);
+        else
+            ranges[size++] = range;
+    }
+    ranges.resize(size);
+}
+
+/// a sorted run of ranges in an (already unlinked) temporary file, read back through a buffer which the merge lends it.
+class range_run {
+    std::unique_ptr<std::FILE, decltype(&std::fclose)> file{std::tmpfile(), &std::fclose};
+    std::span<stored_range> buffer;
+    std::size_t pos{0};
+    std::size_t size{0};
+
+public:
+    range_run() {
+        if (!file) throw std::runtime_error("can't create a run file");
+        // every read and write already moves a whole buffer, so stdio's own buffer would only be memory outside of
+        // the budget.
+        std::setvbuf(file.get(), nullptr, _IONBF, 0);
+    }
+
+    explicit range_run(const std::span<const stored_range> ranges) : range_run() { write(ranges); }
+
+    /// appends to the run, which has to happen before it's opened.
+    void write(const std::span<const stored_range> ranges) {
+        if (std::fwrite(ranges.data(), sizeof(stored_range), ranges.size(), file.get()) != ranges.size())
+            throw std::runtime_error("can't write a run file");
+    }
+
+    /// starts reading the run from its beginning, through `read_buffer`.
+    void open(const std::span<stored_range> read_buffer) {
+        std::rewind(file.get());
+        buffer = read_buffer;
+        pos = size = 0;
+    }
+
+    bool next(stored_range &range) {
+        if (pos == size) {
+            size = std::fread(buffer.data(), sizeof(stored_range), buffer.size(), file.get());
+            pos = 0;
+            if (size == 0) return false;
+        }
+        range = buffer[pos++];
+        return true;
+    }
+};
+
+/// merges the `runs` k-way, each read through its own slice of `scratch`, and calls `emit(stored_range)` for every
+/// merged range in order.
+template<typename F>
+void merge_runs(const std::span<range_run> runs, const std::span<stored_range> scratch, F &&emit) {
+    const auto slice = scratch.size() / runs.size();
+    // the smallest next range of every run, with the index of its run.
+    using head = std::pair<stored_range, std::size_t>;
+    const auto later = [](const head &a, const head &b) { return a.first.first > b.first.first; };
+    std::priority_queue<head, std::vector<head>, decltype(later)> heads{later};
+    for (std::size_t i = 0; i < runs.size(); ++i) {
+        runs[i].open(scratch.subspan(i * slice, slice));
+        if (stored_range range; runs[i].next(range)) heads.emplace(range, i);
+    }
+    if (heads.empty()) return;
+    auto current = heads.top().first;
+    while (!heads.empty()) {
+        const auto [range, i] = heads.top();
+        heads.pop();
+        if (range.first <= current.last + 1) {
+            current.last = std::max(current.last, range.last);
+        } else {
+            emit(current);
+            current = range;
+        }
+        if (stored_range next; runs[i].next(next)) heads.emplace(next, i);
+    }
+    emit(current);
+}
+
+/// merges the `runs` into a single new one, with `scratch` split into the read buffers and a write buffer.
+inline range_run merge_into_run(const std::span<range_run> runs, const std::span<stored_range> scratch) {
+    const auto output = scratch.last(scratch.size() / (runs.size() + 1));
+    range_run result{};
+    std::size_t size{0};
+    merge_runs(runs, scratch.first(scratch.size() - output.size()), [&](const stored_range range) {
+        if (size == output.size()) {
+            result.write(output);
+            size = 0;
+        }
+        output[size++] = range;
+    });
+    result.write(output.first(size));
+    return result;
+}
+
+/// calls `emit(id_range)` for every merged range in order, like `parse_ranges` but keeping at most about
+/// `memory_budget` bytes of ranges in memory.
+template<typename F>
+void merge_ranges_external(const std::string_view input, const std::size_t memory_budget, F &&emit) {
+    // enough runs to make the passes few, few enough to leave every run a read buffer worth a system call.
+    constexpr std::size_t max_fan_in{32};
+    constexpr std::size_t min_read_buffer{512};
+    // a merge of two runs needs two read buffers and a write buffer.
+    const auto capacity = std::max<std::size_t>(memory_budget / sizeof(stored_range), 3);
+    const auto fan_in = std::clamp<std::size_t>(capacity / min_read_buffer, 2, max_fan_in);
+    // the ranges which are read in, and the scratch memory of the merges once they are written to a run.
+    std::vector<stored_range> ranges;
+    ranges.reserve(capacity);
+    const auto scratch = [&] {
+        ranges.resize(capacity);
+        return std::span{ranges};
+    };
+
+    // levels[l] has the runs which are made of fan_in^l runs of read ranges, fewer than fan_in of them.
+    std::vector<std::vector<range_run>> levels;
+    const auto add_run = [&](range_run run) {
+        for (std::size_t l = 0;; ++l) {
+            if (l == levels.size()) levels.emplace_back();
+            levels[l].push_back(std::move(run));
+            if (levels[l].size() < fan_in) break;
+            run = merge_into_run(levels[l], scratch());
+            levels[l].clear();
+        }
+        ranges.clear();
+    };
+    util::scanner s{input};
+    for (std::string_view line; s.read_line(line);) {
+        if (line.empty()) break;
+        const auto [first, last] = parse_range(line);
+        ranges.push_back({first, last});
+        if (ranges.size() == capacity) {
+            merge_in_place(ranges);
+            add_run(range_run{ranges});
+        }
+    }
+    merge_in_place(ranges);
+    if (levels.empty()) {
+        // everything fit into memory after all.
+        for (const auto [first, last]: ranges)
+            emit(id_range{first, last});
+        return;
+    }
+
+    // the smallest runs first, so the passes that are still needed read as little as possible.
+    std::vector<range_run> runs;
+    if (!ranges.empty()) runs.emplace_back(ranges);
+    for (auto &level: levels)
+        for (auto &run: level)
+            runs.push_back(std::move(run));
+    levels.clear();
+    while (runs.size() > fan_in) {
+        auto merged = merge_into_run(std::span{runs}.first(fan_in), scratch());
+        runs.erase(runs.begin(), runs.begin() + static_cast<std::ptrdiff_t>(fan_in));
+        runs.push_back(std::move(merged));
+    }
+    merge_runs(runs, scratch(), [&](const stored_range range) { emit(id_range{range.first, range.last}); });
+}
+
+/// part 2 for range lists bigger than the memory, see `merge_ranges_external`.
+inline long long count_fresh_ids_external(const std::string_view input, const std::size_t memory_budget) {
+    long long count{0};
+    merge_ranges_external(input, memory_budget,
+                          [&](const id_range &range) { count += range.second - range.first + 1; });
+    return count;
+}
+
+struct inventory {
+    std::vector<id_range> ranges;
+    std::vector<long long> ids;
+};
+
+inline inventory parse_inventory(const std::string_view input) {
+    util::scanner s{input};
+    inventory result{.ranges = read_ranges(s)};
+    for (long long id; s.read(id);)
+        result.ids.push_back(id);
+    return result;
+}
+
+/// part 1: how many of the available ids are fresh.
+inline long long count_fresh(const inventory &inv) { return range_index{inv.ranges}.count(inv.ids); }
+
+/// part 2: how many ids the (merged) ranges cover in total.
+inline long long count_fresh_ids(const std::vector<id_range> &ranges) {
+    return std::ranges::fold_left(ranges, 0ll,
+                                  [](const long long a, const id_range &b) { return a + b.second - b.first + 1; });
+}
+
 #endif // LIB06_HPP
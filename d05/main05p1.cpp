@@ -1,23 +1,22 @@
 #include "lib06.hpp"
 
-#include <fstream>
 #include <print>
 #include <utility>
 #include <vector>
 
+#include <input.hpp>
+
 int main() {
-    // std::ifstream f{"../../d05/sample.txt"};
-    std::ifstream f{"../../d05/assignment.txt"};
-    const auto ranges = parse_ranges(f);
-    for (const auto [fst, snd]: ranges) {
+    // const util::mapped_file f{"../../d05/sample.txt"};
+    const util::mapped_file f{"../../d05/assignment.txt"};
+    const auto inv = parse_inventory(f.view());
+    for (const auto [fst, snd]: inv.ranges) {
         std::println("{}-{}", fst, snd);
     }
-    auto fresh_count{0};
-    for (long long id; f >> id;) {
-        const auto fresh = includes_id(ranges, id);
-        if (fresh) ++fresh_count;
-        std::println("id {} is {}.", id, fresh ? "fresh" : "spoiled");
+    const range_index index{inv.ranges};
+    for (const long long id: inv.ids) {
+        std::println("id {} is {}.", id, index.contains(id) ? "fresh" : "spoiled");
     }
-    std::println("Result: {}", fresh_count);
+    std::println("Result: {}", count_fresh(inv));
     return 0;
 }
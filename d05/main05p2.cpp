@@ -1,13 +1,32 @@
 #include "lib06.hpp"
 
-#include <fstream>
+#include <charconv>
+#include <cstddef>
 #include <print>
+#include <string_view>
 
-int main() {
-    // std::ifstream f{"../../d05/sample.txt"};
-    std::ifstream f{"../../d05/assignment.txt"};
-    const long long count = std::ranges::fold_left(
-            parse_ranges(f), 0ll, [](const long long a, const id_range &b) { return a + b.second - b.first + 1; });
-    std::println("Result: {}", count);
+#include <input.hpp>
+
+int main(const int argc, char **argv) {
+    // const util::mapped_file f{"../../d05/sample.txt"};
+    const util::mapped_file f{"../../d05/assignment.txt"};
+    // --memory-budget MB merges the ranges through temporary files, keeping at most MB megabytes of them in memory.
+    if (argc > 2 && std::string_view{argv[1]} == "--memory-budget") {
+        const std::string_view value{argv[2]};
+        std::size_t megabytes{};
+        if (const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), megabytes);
+            ec != std::errc{} || ptr != value.data() + value.size()) {
+            std::println(stderr, "invalid memory budget: {}", value);
+            return 1;
+        }
+        std::println("Result: {}", count_fresh_ids_external(f.view(), megabytes << 20));
+        return 0;
+    }
+    // --incremental inserts the ranges one by one into an interval set.
+    if (argc > 1 && std::string_view{argv[1]} == "--incremental") {
+        std::println("Result: {}", count_fresh_ids_incremental(f.view()));
+        return 0;
+    }
+    std::println("Result: {}", count_fresh_ids(parse_ranges(f.view())));
     return 0;
 }
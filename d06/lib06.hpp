@@ -0,0 +1,180 @@
+#ifndef LIB06_WORKSHEET_HPP
+#define LIB06_WORKSHEET_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <input.hpp>
+#include <parallel.hpp>
+
+struct worksheet {
+    std::vector<long long> numbers;
+    std::vector<char> ops;
+};
+
+inline worksheet parse_worksheet(const std::string_view input) {
+    util::scanner s{input};
+    worksheet result{};
+    for (long long number; s.read(number);)
+        result.numbers.push_back(number);
+    for (char op; s.read(op);)
+        result.ops.push_back(op);
+    return result;
+}
+
+/// part 1: every column of numbers is combined with the operator below it.
+inline long long grand_total(const worksheet &sheet) {
+    const auto &[numbers, ops] = sheet;
+    const auto width = ops.size();
+    const auto height = numbers.size() / width;
+    long long result = 0;
+    for (auto col = 0; col < width; ++col) {
+        long long acc{0};
+        const auto op = ops[col];
+        switch (op) {
+            case '*':
+                acc = 1;
+                break;
+            case '+':
+                acc = 0;
+                break;
+            default:;
+        }
+        for (auto row = 0; row < height; ++row) {
+            const auto idx = row * width + col;
+            switch (op) {
+                case '*':
+                    acc *= numbers[idx];
+                    break;
+                case '+':
+                    acc += numbers[idx];
+                    break;
+                default:;
+            }
+        }
+        result += acc;
+    }
+    return result;
+}
+
+/// part 1 in a single pass over the raw input, without keeping the numbers. The operator line is located first, from
+/// the end of the input, and then every row is added to and multiplied into one accumulator per column. Both
+/// accumulators are updated for every column, which turns the per-row work into two plain loops the compiler
+/// vectorizes; the operator only picks one of them in the end. Unsigned arithmetic, so the unused products may
+/// overflow.
+inline long long grand_total_streaming(std::string_view input) {
+    while (!input.empty() && std::isspace(static_cast<unsigned char>(input.back())))
+        input.remove_suffix(1);
+    const auto ops_start = input.find_last_of('\n') + 1;
+
+    std::vector<char> ops{};
+    util::scanner os{input.substr(ops_start)};
+    for (char op; os.read(op);) {
+        if (op != '*' && op != '+') throw std::invalid_argument(std::format("'{}' must be */+", op));
+        ops.push_back(op);
+    }
+    const auto width = ops.size();
+
+    std::vector<std::uint64_t> row(width), sums(width, 0), products(width, 1);
+    for (const auto line: util::lines{input.substr(0, ops_start)}) {
+        util::scanner s{line};
+        for (auto &number: row)
+            if (!s.read(number)) throw std::invalid_argument(std::format("expected {} numbers per row", width));
+        for (std::size_t col = 0; col < width; ++col)
+            sums[col] += row[col];
+        for (std::size_t col = 0; col < width; ++col)
+            products[col] *= row[col];
+    }
+
+    std::uint64_t result{0};
+    for (std::size_t col = 0; col < width; ++col)
+        result += ops[col] == '*' ? products[col] : sums[col];
+    return static_cast<long long>(result);
+}
+
+inline long long identity(const char op) {
+    if (op == '*') return 1;
+    if (op == '+') return 0;
+    throw std::invalid_argument(std::format("'{}' must be */+", op));
+}
+
+inline std::vector<std::string_view> parse_lines(const std::string_view input) {
+    return {std::from_range, util::lines{input}};
+}
+
+/*
+ * Part 2: numbers are written top to bottom, one per character column. Going through the rows in order and doing
+ * `number = number * 10 + digit` for every column at once builds all of the numbers side by side: reading the rows
+ * contiguously and writing the numbers contiguously is the transposition, and the branchless update of a row is a plain
+ * loop the compiler vectorizes.
+ *
+ * The operator line splits the columns into independent problems. These are grouped into tiles of about
+ * `tile_columns` columns (whole problems only), whose numbers stay in cache while every row passes over them, and the
+ * tiles are spread over the shared pool.
+ */
+
+/// a problem's operator and its columns [first; last).
+struct problem_columns {
+    char op;
+    std::size_t first;
+    std::size_t last;
+};
+
+/// part 2, tile by tile, see above.
+inline long long vertical_grand_total_tiled(const std::vector<std::string_view> &lines,
+                                            const std::size_t tile_columns = 1 << 12) {
+    if (lines.empty()) return 0;
+    const auto op_line = lines.back();
+    const auto rows = std::span{lines}.first(lines.size() - 1);
+    const auto longest = std::ranges::max(lines | std::views::transform(&std::string_view::length));
+
+    // every operator starts a problem, which ends at the blank column before the next one.
+    std::vector<problem_columns> problems{};
+    for (std::size_t col = 0; col < op_line.size(); ++col) {
+        if (op_line[col] == ' ') continue;
+        identity(op_line[col]); // throws for anything but */+
+        if (!problems.empty()) problems.back().last = col - 1;
+        problems.push_back({op_line[col], col, longest});
+    }
+    // tile t covers the problems [tiles[t]; tiles[t + 1]).
+    std::vector<std::size_t> tiles{0};
+    for (std::size_t i = 0; i < problems.size(); ++i)
+        if (problems[i].last - problems[tiles.back()].first >= tile_columns) tiles.push_back(i + 1);
+    if (tiles.back() != problems.size()) tiles.push_back(problems.size());
+
+    return util::parallel_reduce(
+            std::size_t{0}, tiles.size() - 1, 0ll,
+            [&](const std::size_t t) {
+                const auto first = problems[tiles[t]].first;
+                const auto last = problems[tiles[t + 1] - 1].last;
+                std::vector<std::uint64_t> numbers(last - first);
+                for (const auto line: rows) {
+                    const auto end = std::min(last, std::max(first, line.size()));
+                    for (auto col = first; col < end; ++col) {
+                        const auto digit = static_cast<std::uint64_t>(static_cast<unsigned char>(line[col]) - '0');
+                        auto &number = numbers[col - first];
+                        number = digit < 10 ? number * 10 + digit : number;
+                    }
+                }
+                long long sum{0};
+                for (auto i = tiles[t]; i < tiles[t + 1]; ++i) {
+                    auto term = identity(problems[i].op);
+                    for (auto col = problems[i].first; col < problems[i].last; ++col)
+                        term = problems[i].op == '*' ? term * static_cast<long long>(numbers[col - first])
+                                                     : term + static_cast<long long>(numbers[col - first]);
+                    sum += term;
+                }
+                return sum;
+            },
+            std::plus{}, 1);
+}
+
+#endif // LIB06_WORKSHEET_HPP
@@ -1,45 +1,20 @@
-#include <fstream>
 #include <print>
-#include <ranges>
-#include <vector>
+#include <string_view>
 
-int main() {
-    // std::ifstream f{"../../d06/sample.txt"};
-    std::ifstream f{"../../d06/assignment.txt"};
-    const std::vector<long long> numbers = std::ranges::istream_view<long long>{f} | std::ranges::to<std::vector>();
-    f.clear();
-    f.unget();
-    const std::vector<char> ops = std::ranges::istream_view<char>{f} | std::ranges::to<std::vector>();
-    const auto width = ops.size();
-    const auto height = numbers.size() / width;
-    std::println("width {}, height {}", width, height);
-    long long result = 0;
-    for (auto col = 0; col < width; ++col) {
-        long long acc{0};
-        const auto op = ops[col];
-        switch (op) {
-            case '*':
-                acc = 1;
-                break;
-            case '+':
-                acc = 0;
-                break;
-            default:;
-        }
-        for (auto row = 0; row < height; ++row) {
-            const auto idx = row * width + col;
-            switch (op) {
-                case '*':
-                    acc *= numbers[idx];
-                    break;
-                case '+':
-                    acc += numbers[idx];
-                    break;
-                default:;
-            }
-        }
-        result += acc;
+#include <input.hpp>
+
+#include "lib06.hpp"
+
+int main(const int argc, char **argv) {
+    // const util::mapped_file f{"../../d06/sample.txt"};
+    const util::mapped_file f{"../../d06/assignment.txt"};
+    // --streaming reads the worksheet once, keeping one accumulator per column instead of every number.
+    if (argc > 1 && std::string_view{argv[1]} == "--streaming") {
+        std::println("Result: {}", grand_total_streaming(f.view()));
+        return 0;
     }
-    std::println("Result: {}", result);
+    const auto sheet = parse_worksheet(f.view());
+    std::println("width {}, height {}", sheet.ops.size(), sheet.numbers.size() / sheet.ops.size());
+    std::println("Result: {}", grand_total(sheet));
     return 0;
 }
@@ -0,0 +1,139 @@
+#ifndef LIB07_HPP
+#define LIB07_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <input.hpp>
+
+inline std::vector<std::string_view> parse_manifold(const std::string_view input) {
+    return {std::from_range, util::lines{input}};
+}
+
+/// part 1 on bitsets: bit i of a row's words is column i, for the beams as well as the splitters. A beam hitting a
+/// splitter continues in both neighboring columns instead, so a whole row is
+/// `(beams & ~splitters) | (hits << 1) | (hits >> 1)` with `hits = beams & splitters`, 64 columns per operation, and
+/// the splits are the popcount of the hits. Works on any range of lines, like `count_timelines_rolling`.
+template<std::ranges::input_range Lines>
+long long count_splits_bitset(const Lines &lines) {
+    auto it = std::ranges::begin(lines);
+    if (it == std::ranges::end(lines)) return 0;
+    const std::string_view first = *it;
+    // at least one bit to spare, for beams split off the right edge.
+    const auto word_count = first.size() / 64 + 1;
+    std::vector<std::uint64_t> beams(word_count), splitters(word_count), hits(word_count);
+    for (std::size_t col = 0; col < first.size(); ++col)
+        beams[col / 64] |= std::uint64_t{first[col] == 'S'} << (col % 64);
+
+    long long split_count{0};
+    for (++it; it != std::ranges::end(lines); ++it) {
+        const std::string_view line = *it;
+        std::ranges::fill(splitters, 0);
+        for (std::size_t col = 0; col < std::min(line.size(), first.size()); ++col)
+            splitters[col / 64] |= std::uint64_t{line[col] == '^'} << (col % 64);
+        for (std::size_t w = 0; w < word_count; ++w) {
+            hits[w] = beams[w] & splitters[w];
+            split_count += std::popcount(hits[w]);
+        }
+        for (std::size_t w = 0; w < word_count; ++w) {
+            const auto from_previous = w > 0 ? hits[w - 1] >> 63 : 0;
+            const auto from_next = w + 1 < word_count ? hits[w + 1] << 63 : 0;
+            beams[w] = (beams[w] & ~splitters[w]) | hits[w] << 1 | hits[w] >> 1 | from_previous | from_next;
+        }
+    }
+    return split_count;
+}
+
+/// part 2: how many timelines have a beam in each column, updated one row at a time. Only that
+/// row and the next one are kept, so `lines` can just as well stream straight out of the input, for manifolds of any
+/// height.
+template<std::ranges::input_range Lines>
+constexpr long long count_timelines_rolling(const Lines &lines) {
+    auto it = std::ranges::begin(lines);
+    if (it == std::ranges::end(lines)) return 0;
+    const std::string_view first = *it;
+    const auto start = first.find('S');
+    if (start == std::string_view::npos) throw std::invalid_argument("the first line has no 'S'");
+    // column i is column i - 1 of the manifold, which leaves room for beams split off either edge. Like in
+    // `count_splits_bitset`, the manifold is as wide as its first line, and beams past it go straight down.
+    std::vector<long long> current(first.size() + 2), next(first.size() + 2);
+    current[start + 1] = 1;
+    for (++it; it != std::ranges::end(lines); ++it) {
+        const std::string_view line = *it;
+        std::ranges::fill(next, 0);
+        for (std::size_t col = 0; col < current.size(); ++col) {
+            if (current[col] == 0) continue;
+            if (col > 0 && col - 1 < std::min(line.size(), first.size()) && line[col - 1] == '^') {
+                next[col - 1] += current[col];
+                next[col + 1] += current[col];
+            } else {
+                next[col] += current[col];
+            }
+        }
+        std::swap(current, next);
+    }
+    return std::ranges::fold_left(current, 0ll, std::plus{});
+}
+
+static_assert(count_timelines_rolling(std::array<std::string_view, 4>{".S.", ".^.", "^.^", "..."}) == 4);
+// a line wider than the first one, with a splitter under the beam that was split off the right edge.
+static_assert(count_timelines_rolling(std::array<std::string_view, 3>{"S", "^", ".^"}) == 2);
+
+/*
+ * Paths from anywhere: going bottom-up, the amount of paths from a cell to the bottom only depends on the row below it,
+ * which gives every cell's count in a single sweep. That sweep only needs two rows of counts at a time, and it answers
+ * "how many timelines if the beam enters here" for every entry point in a row as it passes that row, so any amount of
+ * them take one sweep and no more memory than the rows.
+ */
+
+/// a cell of the manifold, where `col` may be one column off either edge.
+struct cell {
+    std::size_t row;
+    int col;
+};
+
+/// the amount of paths to the bottom from each of the `cells`. Like in `count_timelines_rolling`, the manifold is as
+/// wide as its first line.
+constexpr std::vector<long long> paths_from(const std::vector<std::string_view> &lines,
+                                            const std::span<const cell> cells) {
+    const auto width = lines.empty() ? 0 : lines.front().size();
+    // the cells bottom-up, in the order the sweep reaches their rows.
+    std::vector<std::size_t> order(cells.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::ranges::sort(order, std::greater{}, [&](const std::size_t i) { return cells[i].row; });
+
+    std::vector<long long> result(cells.size());
+    // column i is column i - 1 of the manifold, for beams split off either edge, which go straight down. Below the
+    // last row is the bottom edge, with one path everywhere.
+    std::vector<long long> below(width + 2, 1), here(width + 2);
+    auto next = order.begin();
+    for (auto row = lines.size(); row-- > 0 && next != order.end();) {
+        const auto line = lines[row];
+        for (std::size_t col = 0; col < here.size(); ++col) {
+            const bool split = col > 0 && col - 1 < std::min(line.size(), width) && line[col - 1] == '^';
+            here[col] = split ? below[col - 1] + below[col + 1] : below[col];
+        }
+        std::swap(below, here);
+        for (; next != order.end() && cells[*next].row == row; ++next)
+            result[*next] = below[static_cast<std::size_t>(cells[*next].col + 1)];
+    }
+    return result;
+}
+
+// the beam entering below `S` has as many paths as there are timelines, ragged lines included.
+static_assert(paths_from({".S.", ".^.", "^.^", "..."}, std::array{cell{1, 1}})[0] == 4);
+static_assert(paths_from({"S", "^", ".^"}, std::array{cell{1, 0}})[0] ==
+              count_timelines_rolling(std::array<std::string_view, 3>{"S", "^", ".^"}));
+
+#endif // LIB07_HPP
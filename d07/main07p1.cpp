@@ -1,30 +1,12 @@
-#include <algorithm>
-#include <fstream>
 #include <print>
-#include <ranges>
-#include <string>
+
+#include <input.hpp>
+
+#include "lib07.hpp"
 
 int main() {
-    // std::ifstream f{"../../d07/sample.txt"};
-    std::ifstream f{"../../d07/assignment.txt"};
-    std::string previous_line;
-    std::getline(f, previous_line);
-    std::ranges::replace(previous_line, 'S', '|');
-    long long split_count = 0;
-    for (std::string line; std::getline(f, line);) {
-        for (auto i = 0; i < line.length(); ++i) {
-            if (previous_line[i] == '|') {
-                if (line[i] == '^') {
-                    line[i-1] = '|';
-                    line[i+1] = '|';
-                    ++split_count;
-                } else {
-                    line[i] = '|';
-                }
-            }
-        }
-        previous_line = std::move(line);
-    }
-    std::println("Result: {}", split_count);
+    // const util::mapped_file f{"../../d07/sample.txt"};
+    const util::mapped_file f{"../../d07/assignment.txt"};
+    std::println("Result: {}", count_splits_bitset(util::lines{f.view()}));
     return 0;
 }
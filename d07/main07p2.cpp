@@ -1,58 +1,37 @@
-#include <algorithm>
-#include <fstream>
-#include <map>
+#include <charconv>
+#include <cstddef>
 #include <print>
-#include <ranges>
-#include <string>
+#include <string_view>
 #include <vector>
 
-static std::map<std::pair<int, int>, long long> cache{};
+#include <input.hpp>
 
-/*
- *
- * we're doing this with dirty, dirty recursion. However:
- * 1. Stack-wise it's fine, because the maximum depth of the stack is the number of lines in the file.
- * 2. We can prove that it terminates.
- * Both of these points are proven by the recursion: A recursion call is always done with row + 1.
- * Since the termination of recursion is based on row being bigger or equal lines.size(), which does not change,
- * we know that recursion must terminate.
- * The worse case run-time is O(2^n), which is horrible, because at every layer, we could double the recursion width.
- * In practice, since there is a finite amount of values for col, we can cache the results very well. The result of a
- * row/col pair is always the same.
- * Meaning that the amount of different possible function calls has been reduced to O(n^2 m),
- * with n being the amount of lines, and m being the length of those lines. At least I think so.
- *
- * Intuitively, we can think of this in the way that multiple paths of the beam could lead to coordinate i,j.
- * But we know that it doesn't matter where the beam came from, the amount of paths from there is the same.
- * Meaning, we only need to calculate that once.
- *
- * In practice, not including the caching resulted in execution time that outlasted my patience.
- * Adding caching cut it down to basically instantaneous.
- *
- * Converting this to iteration would be easy, but since I haven't used recursion yet in this AOC, I just felt like it.
- *
- */
+#include "lib07.hpp"
 
-
-long long count_paths(const std::vector<std::string> &lines, const int row, const int col) {
-    if (row >= lines.size()) return 1;
-    if (const auto it = cache.find({row, col}); it != cache.end()) return it->second;
-    long long result;
-    if (const char c = lines[row][col]; c == '^')
-        result = count_paths(lines, row + 1, col - 1) + count_paths(lines, row + 1, col + 1);
-    else
-        result = count_paths(lines, row + 1, col);
-    cache[{row, col}] = result;
-    return result;
-}
-
-int main() {
-    // std::ifstream f{"../../d07/sample.txt"};
-    std::ifstream f{"../../d07/assignment.txt"};
-    std::vector<std::string> lines{};
-    for (std::string line; std::getline(f, line);)
-        lines.emplace_back(std::move(line));
-    const auto count = count_paths(lines, 1, static_cast<int>(lines.front().find('S')));
-    std::println("Result: {}", count);
+int main(const int argc, char **argv) {
+    // const util::mapped_file f{"../../d07/sample.txt"};
+    const util::mapped_file f{"../../d07/assignment.txt"};
+    // --from ROW COL ... counts the timelines of beams entering at any amount of other cells.
+    if (argc > 1 && std::string_view{argv[1]} == "--from") {
+        const auto lines = parse_manifold(f.view());
+        std::vector<cell> cells{};
+        for (auto i{2}; i + 1 < argc; i += 2) {
+            const std::string_view row_arg{argv[i]}, col_arg{argv[i + 1]};
+            std::size_t row{};
+            int col{};
+            if (std::from_chars(row_arg.data(), row_arg.data() + row_arg.size(), row).ec != std::errc{} ||
+                std::from_chars(col_arg.data(), col_arg.data() + col_arg.size(), col).ec != std::errc{} ||
+                row >= lines.size() || col < 0 || col >= static_cast<int>(lines.front().size())) {
+                std::println(stderr, "invalid cell: {} {}", row_arg, col_arg);
+                return 1;
+            }
+            cells.push_back({row, col});
+        }
+        const auto paths = paths_from(lines, cells);
+        for (std::size_t i = 0; i < cells.size(); ++i)
+            std::println("From {},{}: {}", cells[i].row, cells[i].col, paths[i]);
+        return 0;
+    }
+    std::println("Result: {}", count_timelines_rolling(util::lines{f.view()}));
     return 0;
 }
@@ -2,14 +2,21 @@
 #define LIB08_HPP
 #include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <format>
-#include <fstream>
-#include <map>
+#include <functional>
+#include <limits>
+#include <numeric>
 #include <print>
 #include <ranges>
-#include <sstream>
+#include <string_view>
+#include <tuple>
+#include <utility>
 #include <vector>
 
+#include <input.hpp>
+
 union int3 {
     struct {
         int x, y, z;
@@ -28,14 +35,13 @@ struct std::formatter<int3> : std::formatter<char> {
 
 struct box {
     int3 pos;
-    int circuit_id;
 };
 
 template<>
 struct std::formatter<box> : std::formatter<char> {
     template<class FmtContext>
     FmtContext::iterator format(const box v, FmtContext &ctx) const {
-        return std::format_to(ctx.out(), "{{{}, {}}}", v.pos, v.circuit_id);
+        return std::format_to(ctx.out(), "{{{}}}", v.pos);
     }
 };
 
@@ -56,87 +62,291 @@ struct std::formatter<box_pair> : std::formatter<char> {
     }
 };
 
-inline void run(bool sample, bool part1) {
-    std::ifstream f{sample ? "../../d08/sample.txt" : "../../d08/assignment.txt"};
-    const int k = sample ? 10 : 1000;
+inline std::vector<box> parse_boxes(const std::string_view input) {
     std::vector<box> boxes;
-    for (std::string line; std::getline(f, line);) {
-        std::stringstream ss{std::move(line)};
-        int3 pos{};
-        char comma;
-        ss >> pos.x >> comma >> pos.y >> comma >> pos.z;
-        boxes.emplace_back(pos, -1);
+    util::scanner s{input};
+    int3 pos{};
+    char comma;
+    while (s.read(pos.x) && s.read(comma) && s.read(pos.y) && s.read(comma) && s.read(pos.z))
+        boxes.emplace_back(pos);
+    return boxes;
+}
+
+/// disjoint-set forest over the boxes, every box starting out as its own circuit. Finding a circuit halves the path to
+/// its root along the way, and merging hangs the smaller circuit below the larger one, which keeps the trees flat.
+class disjoint_sets {
+    std::vector<int> parents;
+    // only up to date for roots.
+    std::vector<int> sizes;
+    int set_count;
+
+public:
+    explicit disjoint_sets(const int count) : parents(count), sizes(count, 1), set_count{count} {
+        std::iota(parents.begin(), parents.end(), 0);
+    }
+
+    [[nodiscard]] int find(int i) {
+        while (parents[i] != i)
+            i = parents[i] = parents[parents[i]];
+        return i;
+    }
+
+    /// merges the circuits of a and b. Returns false if they already were one.
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (sizes[a] < sizes[b]) std::swap(a, b);
+        parents[b] = a;
+        sizes[a] += sizes[b];
+        --set_count;
+        return true;
+    }
+
+    [[nodiscard]] int size_of(const int i) { return sizes[find(i)]; }
+
+    /// amount of circuits, single boxes included.
+    [[nodiscard]] int count() const { return set_count; }
+
+    /// the size of every circuit, single boxes included.
+    [[nodiscard]] std::vector<int> component_sizes() const {
+        std::vector<int> result{};
+        result.reserve(set_count);
+        for (std::size_t i = 0; i < parents.size(); ++i)
+            if (parents[i] == static_cast<int>(i)) result.push_back(sizes[i]);
+        return result;
     }
+};
+
+inline std::uint64_t three_largest_product(const disjoint_sets &circuits) {
+    auto sizes = circuits.component_sizes();
+    const auto top = std::min<std::size_t>(3, sizes.size());
+    std::ranges::partial_sort(sizes.begin(), sizes.begin() + top, sizes.end(), std::greater{});
+    return std::ranges::fold_left(sizes | std::views::take(top), std::uint64_t{1}, std::multiplies{});
+}
+
+/*
+ * Neither part needs all n^2 / 2 pairs. A k-d tree over the boxes finds close pairs while skipping every subtree whose
+ * bounding box is already too far away:
+ * - part 1 keeps the k closest pairs found so far in a heap, the furthest of which bounds the search.
+ * - part 2 is the last pair Kruskal would connect, which is the longest edge of the minimum spanning tree. Borůvka
+ *   builds that tree in O(log n) rounds, in each of which every circuit looks for the closest box in any other circuit.
+ *   Subtrees lying entirely within the searching circuit are skipped as well.
+ * Both keep O(n + k) memory.
+ */
+
+/// the order in which Kruskal connects pairs, ties broken by the indices.
+inline bool closer(const box_pair &a, const box_pair &b) {
+    return std::tie(a.square_dist, a.ia, a.ib) < std::tie(b.square_dist, b.ia, b.ib);
+}
+
+inline double square_distance(const int3 a, const int3 b) {
+    return static_cast<double>(b.x - a.x) * (b.x - a.x) + static_cast<double>(b.y - a.y) * (b.y - a.y)
+            + static_cast<double>(b.z - a.z) * (b.z - a.z);
+}
+
+class kd_tree {
+    static constexpr int leaf_size{8};
+    static constexpr double infinity{std::numeric_limits<double>::infinity()};
+
+    struct node {
+        int3 lower, upper;
+        // the boxes of the node are order[begin; end).
+        int begin, end;
+        // both -1 for leaves.
+        int left{-1}, right{-1};
+        // the circuit every box of the node is in, or -1 if they're in different ones.
+        int circuit{-1};
+    };
+
+    const std::vector<box> &boxes;
+    std::vector<int> order;
+    std::vector<node> nodes;
 
-    // what's the worst that could happen?
-    std::vector<box_pair> all_pairs{};
-    for (auto i = 0; i < boxes.size() - 1; ++i) {
-        const auto a = boxes[i].pos;
-        for (auto j = i + 1; j < boxes.size(); ++j) {
-            const auto b = boxes[j].pos;
-            all_pairs.emplace_back(i, j,
-                                   static_cast<double>(b.x - a.x) * (b.x - a.x)
-                                           + static_cast<double>(b.y - a.y) * (b.y - a.y)
-                                           + static_cast<double>(b.z - a.z) * (b.z - a.z));
+    int build(const int begin, const int end) {
+        node n{.lower = boxes[order[begin]].pos, .upper = boxes[order[begin]].pos, .begin = begin, .end = end};
+        for (auto i = begin + 1; i < end; ++i) {
+            for (auto axis{0}; axis < 3; ++axis) {
+                n.lower.data[axis] = std::min(n.lower.data[axis], boxes[order[i]].pos.data[axis]);
+                n.upper.data[axis] = std::max(n.upper.data[axis], boxes[order[i]].pos.data[axis]);
+            }
         }
+        const auto index = static_cast<int>(nodes.size());
+        nodes.push_back(n);
+        if (end - begin <= leaf_size) return index;
+        // split at the median of the widest axis.
+        auto axis{0};
+        for (auto a{1}; a < 3; ++a)
+            if (n.upper.data[a] - n.lower.data[a] > n.upper.data[axis] - n.lower.data[axis]) axis = a;
+        const auto mid = begin + (end - begin) / 2;
+        std::ranges::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end, {},
+                                 [&](const int i) { return boxes[i].pos.data[axis]; });
+        const auto left = build(begin, mid);
+        const auto right = build(mid, end);
+        nodes[index].left = left;
+        nodes[index].right = right;
+        return index;
     }
-    if (part1) {
-        std::ranges::partial_sort(all_pairs.begin(), all_pairs.begin() + k, all_pairs.end(), {},
-                                  &box_pair::square_dist);
-        all_pairs.resize(k);
-    } else
-        std::ranges::sort(all_pairs, {}, &box_pair::square_dist);
-
-    int last_circuit_id = -1;
-    std::map<int, std::vector<int>> circuits{};
-
-    box_pair last_to_connect{};
-
-    for (const auto pair: all_pairs) {
-        const int ia = pair.ia;
-        const int ib = pair.ib;
-        if (box &box_a = boxes[ia], &box_b = boxes[ib]; box_a.circuit_id == -1 && box_b.circuit_id == -1) {
-            std::println("Forming new circuit between {} and {} ({})", box_a, box_b, pair.square_dist);
-            const int new_circuit_id = ++last_circuit_id;
-            box_a.circuit_id = new_circuit_id;
-            box_b.circuit_id = new_circuit_id;
-            circuits[new_circuit_id] = std::vector{ia, ib};
-        } else if (box_a.circuit_id == -1) {
-            std::println("a Adding {} to {}", box_a, box_b);
-            box_a.circuit_id = box_b.circuit_id;
-            circuits[box_b.circuit_id].emplace_back(ia);
-        } else if (box_b.circuit_id == -1) {
-            std::println("b Adding {} to {}", box_b, box_a);
-            box_b.circuit_id = box_a.circuit_id;
-            circuits[box_a.circuit_id].emplace_back(ib);
-        } else if (box_a.circuit_id != box_b.circuit_id) {
-            const int new_circuit_id = box_a.circuit_id;
-            const int old_circuit_id = box_b.circuit_id;
-            std::println("Merging {} into {}", old_circuit_id, new_circuit_id);
-            for (int b_member: circuits[old_circuit_id])
-                boxes[b_member].circuit_id = new_circuit_id;
-            circuits[new_circuit_id].append_range(std::move(circuits[old_circuit_id]));
-            circuits.erase(old_circuit_id);
+
+    /// square distance from `p` to the bounding box of a node, 0 if it's inside.
+    [[nodiscard]] static double distance_to(const node &n, const int3 p) {
+        double result{0};
+        for (auto axis{0}; axis < 3; ++axis) {
+            const auto d = std::max({n.lower.data[axis] - p.data[axis], 0, p.data[axis] - n.upper.data[axis]});
+            result += static_cast<double>(d) * d;
+        }
+        return result;
+    }
+
+    /// calls `f(j)` for the boxes in every leaf that isn't skipped or further from `p` than `bound()`, nearer subtrees
+    /// first, so the bound tightens early.
+    template<typename Bound, typename Skip, typename F>
+    void search(const int index, const int3 p, const Bound &bound, const Skip &skip, const F &f) const {
+        const auto &n = nodes[index];
+        if (skip(n) || distance_to(n, p) > bound()) return;
+        if (n.left < 0) {
+            for (auto i = n.begin; i < n.end; ++i)
+                f(order[i]);
+            return;
+        }
+        auto near = n.left, far = n.right;
+        if (distance_to(nodes[far], p) < distance_to(nodes[near], p)) std::swap(near, far);
+        search(near, p, bound, skip, f);
+        search(far, p, bound, skip, f);
+    }
+
+    /// marks the nodes whose boxes are all in the same circuit.
+    int tag_circuits(const int index, const std::vector<int> &roots) {
+        auto &n = nodes[index];
+        if (n.left < 0) {
+            n.circuit = roots[order[n.begin]];
+            for (auto i = n.begin + 1; i < n.end; ++i)
+                if (roots[order[i]] != n.circuit) n.circuit = -1;
         } else {
-            // std::println("{} and {} already of same circuit", box_a, box_b);
-            continue;
+            const auto left = tag_circuits(n.left, roots);
+            const auto right = tag_circuits(n.right, roots);
+            n.circuit = left == right ? left : -1;
         }
-        last_to_connect = pair;
+        return n.circuit;
     }
 
-    if (part1) {
-        std::vector<size_t> sizes = circuits
-                | std::views::transform([](auto &&p) { return p.second.size(); })
-                | std::ranges::to<std::vector>();
+public:
+    explicit kd_tree(const std::vector<box> &boxes) : boxes{boxes}, order(boxes.size()) {
+        std::iota(order.begin(), order.end(), 0);
+        if (!boxes.empty()) build(0, static_cast<int>(boxes.size()));
+    }
 
-        std::ranges::partial_sort(sizes.begin(), sizes.begin() + 3, sizes.end(), std::greater{});
-        const auto product = std::ranges::fold_left(sizes | std::views::take(3), 1, std::multiplies{});
+    /// the k closest pairs, closest first.
+    [[nodiscard]] std::vector<box_pair> closest_pairs(const std::size_t k) const {
+        // a max-heap, with the furthest of the pairs so far on top.
+        std::vector<box_pair> heap{};
+        if (k == 0 || nodes.empty()) return heap;
+        heap.reserve(k);
+        const auto bound = [&] { return heap.size() < k ? infinity : heap.front().square_dist; };
+        const auto skip_none = [](const node &) { return false; };
+        for (auto i{0}; i < static_cast<int>(boxes.size()); ++i) {
+            const auto p = boxes[i].pos;
+            search(0, p, bound, skip_none, [&](const int j) {
+                // every pair once.
+                if (j <= i) return;
+                const box_pair pair{i, j, square_distance(p, boxes[j].pos)};
+                if (heap.size() < k) {
+                    heap.push_back(pair);
+                    std::ranges::push_heap(heap, closer);
+                } else if (closer(pair, heap.front())) {
+                    std::ranges::pop_heap(heap, closer);
+                    heap.back() = pair;
+                    std::ranges::push_heap(heap, closer);
+                }
+            });
+        }
+        std::ranges::sort_heap(heap, closer);
+        return heap;
+    }
 
-        std::println("Result: {}", product);
+    /// the edges of the minimum spanning tree over all boxes, using Borůvka's algorithm.
+    [[nodiscard]] std::vector<box_pair> spanning_tree() {
+        const auto n = static_cast<int>(boxes.size());
+        disjoint_sets circuits{n};
+        std::vector<box_pair> edges{};
+        std::vector<int> roots(n);
+        // the closest pair leaving every circuit, by its root.
+        std::vector<box_pair> best(n);
+        while (circuits.count() > 1) {
+            for (auto i{0}; i < n; ++i)
+                roots[i] = circuits.find(i);
+            tag_circuits(0, roots);
+            std::ranges::fill(best, box_pair{-1, -1, infinity});
+            for (auto i{0}; i < n; ++i) {
+                const auto root = roots[i];
+                const auto p = boxes[i].pos;
+                search(
+                        0, p, [&] { return best[root].square_dist; },
+                        [&](const node &nd) { return nd.circuit == root; },
+                        [&](const int j) {
+                            if (roots[j] == root) return;
+                            const box_pair pair{std::min(i, j), std::max(i, j), square_distance(p, boxes[j].pos)};
+                            if (closer(pair, best[root])) best[root] = pair;
+                        });
+            }
+            // with ties broken the same way everywhere, these are all edges of the one minimum spanning tree. Two
+            // circuits can still pick the same edge, which is only added once.
+            for (auto i{0}; i < n; ++i)
+                if (roots[i] == i && best[i].ia >= 0 && circuits.unite(best[i].ia, best[i].ib))
+                    edges.push_back(best[i]);
+        }
+        return edges;
+    }
+};
+
+/// part 1 on the k-d tree, see above.
+inline std::uint64_t largest_circuits_product_indexed(const std::vector<box> &boxes, const int k) {
+    disjoint_sets circuits{static_cast<int>(boxes.size())};
+    for (const auto pair: kd_tree{boxes}.closest_pairs(k))
+        circuits.unite(pair.ia, pair.ib);
+    return three_largest_product(circuits);
+}
+
+/// part 2 as the longest edge of the minimum spanning tree, see above.
+inline std::uint64_t last_connection_product_emst(const std::vector<box> &boxes) {
+    const auto edges = kd_tree{boxes}.spanning_tree();
+    if (edges.empty()) return 0;
+    const auto last = std::ranges::max(edges, closer);
+    return static_cast<std::uint64_t>(boxes[last.ia].pos.x) * boxes[last.ib].pos.x;
+}
+
+/// the parts with the circuit bookkeeping printed along the way.
+inline void run(bool sample, bool part1) {
+    const util::mapped_file f{sample ? "../../d08/sample.txt" : "../../d08/assignment.txt"};
+    const int k = sample ? 10 : 1000;
+    const auto boxes = parse_boxes(f.view());
+    kd_tree tree{boxes};
+    if (part1) {
+        disjoint_sets circuits{static_cast<int>(boxes.size())};
+        for (const auto pair: tree.closest_pairs(k)) {
+            const int ia = pair.ia;
+            const int ib = pair.ib;
+            if (circuits.find(ia) == circuits.find(ib)) continue;
+            if (circuits.size_of(ia) == 1 && circuits.size_of(ib) == 1)
+                std::println("Forming new circuit between {} and {} ({})", boxes[ia], boxes[ib], pair.square_dist);
+            else if (circuits.size_of(ia) == 1)
+                std::println("a Adding {} to {}", boxes[ia], boxes[ib]);
+            else if (circuits.size_of(ib) == 1)
+                std::println("b Adding {} to {}", boxes[ib], boxes[ia]);
+            else
+                std::println("Merging {} into {}", circuits.find(ib), circuits.find(ia));
+            circuits.unite(ia, ib);
+        }
+        std::println("Result: {}", three_largest_product(circuits));
     } else {
-        std::println("Last to connect: {} to {}", boxes[last_to_connect.ia], boxes[last_to_connect.ib]);
-        std::println("Result: {}",
-                     static_cast<uint64_t>(boxes[last_to_connect.ia].pos.x) * boxes[last_to_connect.ib].pos.x);
+        const auto edges = tree.spanning_tree();
+        if (edges.empty()) {
+            std::println("Result: 0");
+            return;
+        }
+        const auto last = std::ranges::max(edges, closer);
+        std::println("Last to connect: {} to {}", boxes[last.ia], boxes[last.ib]);
+        std::println("Result: {}", static_cast<std::uint64_t>(boxes[last.ia].pos.x) * boxes[last.ib].pos.x);
     }
 }
 #endif // LIB08_HPP
@@ -0,0 +1,74 @@
+#ifndef LIB10_HPP
+#define LIB10_HPP
+
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <input.hpp>
+#include <parallel.hpp>
+
+#include <lexy/action/parse.hpp>
+#include <lexy/input/string_input.hpp>
+#include <lexy_ext/report_error.hpp>
+
+#include "model.hpp"
+
+inline std::vector<ast::machine> parse_machines(const std::string_view input) {
+    std::vector<ast::machine> machines{};
+    for (const auto line: util::lines{input})
+        machines.emplace_back(
+                lexy::parse<grammar::machine>(lexy::string_input(line), lexy_ext::report_error).value());
+    return machines;
+}
+
+inline ast::indicator_light toggle(const ast::indicator_light &l) {
+    switch (l) {
+        case ast::indicator_light::OFF:
+            return ast::indicator_light::ON;
+        case ast::indicator_light::ON:
+            return ast::indicator_light::OFF;
+    }
+    throw std::invalid_argument("neither on nor off");
+}
+
+struct light_presses {
+    int count{INT_MAX};
+    /// bit i set if button i is pressed.
+    std::uint64_t mask{0};
+};
+
+/// part 1: brute-forces every button subset, since pressing a button twice is the same as not pressing it.
+inline light_presses fewest_light_presses(const ast::machine &machine) {
+    const auto button_count = machine.buttons.size();
+    light_presses smallest{};
+    for (std::uint64_t mask = 0; mask < 1ull << button_count; ++mask) {
+        if (std::popcount(mask) >= smallest.count) continue;
+        std::vector state(machine.target.size(), ast::indicator_light::OFF);
+        for (int i = 0; i < button_count; ++i) {
+            if (mask & 1 << i) {
+                for (auto &&flip: machine.buttons[i]) {
+                    state[flip] = toggle(state[flip]);
+                }
+            }
+        }
+        if (state != machine.target) continue;
+        smallest = {.count = std::popcount(mask), .mask = mask};
+    }
+    return smallest;
+}
+
+/// part 1, with the machines spread over the shared pool.
+inline long long total_light_presses(const std::vector<ast::machine> &machines) {
+    return util::parallel_reduce(
+            std::size_t{0}, machines.size(), 0ll,
+            [&](const std::size_t i) { return static_cast<long long>(fewest_light_presses(machines[i]).count); },
+            std::plus{}, 1);
+}
+
+#endif // LIB10_HPP
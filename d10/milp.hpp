@@ -0,0 +1,92 @@
+#ifndef MILP_HPP
+#define MILP_HPP
+
+#include <algorithm>
+#include <format>
+#include <print>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <scip.hpp>
+
+#include "lib10.hpp"
+
+/// solves one machine, setting `push_count` to -1 if it has no solution. `verbose` prints the model and the solution.
+inline SCIP_RETCODE solve_machine(SCIP *scip, const ast::machine &machine, int &push_count, const bool verbose) {
+    SCIP_CALL(SCIPcreateProbBasic(scip, "machine"));
+
+    std::vector<SCIP_VAR *> vars{};
+    for (int i = 0; i < machine.buttons.size(); ++i) {
+        SCIP_VAR *var;
+        SCIP_CALL(SCIPcreateVarBasic(scip, &var, nullptr, 0, SCIPinfinity(scip), 1, SCIP_VARTYPE_INTEGER));
+        SCIP_CALL(SCIPaddVar(scip, var));
+        vars.push_back(var);
+    }
+
+    std::vector<SCIP_CONS *> constraints{};
+    std::vector<std::string> constraint_names{};
+    for (int i = 0; i < machine.joltage_target.size(); ++i) {
+        SCIP_CONS *cons;
+        const auto target = machine.joltage_target[i];
+        constraint_names.push_back(std::format("const{}", i));
+        SCIP_CALL(SCIPcreateConsBasicLinear(scip, &cons, constraint_names.back().c_str(), 0, nullptr, nullptr, target,
+                                            target));
+        for (int b = 0; b < machine.buttons.size(); ++b) {
+            if (std::ranges::find(machine.buttons[b], i) != machine.buttons[b].end()) {
+                if (verbose) std::println("Button at {} affects {} to become {}", b, i, target);
+                SCIP_CALL(SCIPaddCoefLinear(scip, cons, vars[b], 1.0));
+            }
+        }
+        SCIP_CALL(SCIPaddCons(scip, cons));
+        constraints.push_back(cons);
+    }
+
+    SCIP_CALL(SCIPsolve(scip));
+
+    if (SCIP_SOL *sol = SCIPgetBestSol(scip); sol != nullptr) {
+        push_count = static_cast<int>(SCIPgetSolOrigObj(scip, sol) + 0.5);
+        if (verbose) {
+            std::println("Solution found:");
+            for (int i = 0; i < vars.size(); ++i)
+                std::print("b{} = {}, ", i, SCIPgetSolVal(scip, sol, vars[i]));
+            std::println("Objective = {}", push_count);
+        }
+    } else {
+        push_count = -1;
+        if (verbose) std::println("No solution found.");
+    }
+
+    for (auto &&var: vars)
+        SCIP_CALL(SCIPreleaseVar(scip, &var));
+    for (auto &&cons: constraints)
+        SCIP_CALL(SCIPreleaseCons(scip, &cons));
+    return SCIP_OKAY;
+}
+
+/// adds up the pushes of every machine. Machines without a solution don't add anything, like they used to.
+inline SCIP_RETCODE solve_machines(SCIP *scip, const std::vector<ast::machine> &machines, long long &total,
+                                   const bool verbose) {
+    if (!verbose) SCIP_CALL(SCIPsetIntParam(scip, "display/verblevel", 0));
+    total = 0;
+    for (const auto &machine: machines) {
+        if (verbose) std::println("{}", machine);
+        int push_count;
+        SCIP_CALL(solve_machine(scip, machine, push_count, verbose));
+        if (push_count >= 0) total += push_count;
+    }
+    return SCIP_OKAY;
+}
+
+/// part 2: every machine is an integer linear program, minimizing the total amount of button presses. `Verbose` prints
+/// every machine's model and solution, as d10p2 does.
+template<bool Verbose = false>
+long long total_joltage_presses(const std::vector<ast::machine> &machines) {
+    const util::scip_instance scip{};
+    long long total;
+    if (const auto retcode = solve_machines(scip.get(), machines, total, Verbose); retcode != SCIP_OKAY)
+        throw std::runtime_error(std::format("SCIP failed with {}", static_cast<int>(retcode)));
+    return total;
+}
+
+#endif // MILP_HPP
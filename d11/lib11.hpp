@@ -0,0 +1,49 @@
+#ifndef LIB11_HPP
+#define LIB11_HPP
+
+#include <map>
+#include <tuple>
+
+#include "model.hpp"
+
+inline int count_paths(const graph_struct &graph, const int from, const int to) {
+    if (from == to) return 1;
+    int total = 0;
+    for (const auto &next: graph.edges.at(from))
+        total += count_paths(graph, next, to);
+    return total;
+}
+
+using path_cache = std::map<std::tuple<int, int, int, int, bool, bool>, long long>;
+
+inline long long count_paths(path_cache &cache, const graph_struct &graph, const int from, const int to,
+                             const int find_a, const int find_b, bool found_a = false, bool found_b = false) {
+    const std::tuple key{from, to, find_a, find_b, !!found_a, !!found_b};
+    if (const auto v = cache.find(key); v != cache.end()) return v->second;
+    if (from == find_a) found_a = true;
+    if (from == find_b) found_b = true;
+    if (from == to) return found_a && found_b ? 1 : 0;
+    long long total = 0;
+    for (const auto &next: graph.edges.at(from))
+        total += count_paths(cache, graph, next, to, find_a, find_b, found_a, found_b);
+    cache[key] = total;
+    return total;
+}
+
+/// part 1: every path from `you` to `out`.
+inline int count_you_paths(const graph_struct &graph) {
+    return count_paths(graph, graph.name_to_index.at("you"), graph.name_to_index.at("out"));
+}
+
+/// part 2: every path from `svr` to `out` that visits both `dac` and `fft`.
+inline long long count_server_paths(const graph_struct &graph) {
+    const int from = graph.name_to_index.at("svr");
+    const int to = graph.name_to_index.at("out");
+    const int dac = graph.name_to_index.at("dac");
+    const int fft = graph.name_to_index.at("fft");
+
+    path_cache cache{};
+    return count_paths(cache, graph, from, to, dac, fft);
+}
+
+#endif // LIB11_HPP
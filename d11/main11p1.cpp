@@ -1,27 +1,17 @@
-#include <fstream>
-#include <map>
 #include <print>
-#include <string>
-#include <vector>
 
-#include "model.hpp"
+#include <input.hpp>
 
-int count_paths(const graph_struct &graph, const int from, const int to) {
-    if (from == to) return 1;
-    int total = 0;
-    for (const auto &next: graph.edges.at(from))
-        total += count_paths(graph, next, to);
-    return total;
-}
+#include "lib11.hpp"
 
 int main() {
-    // std::ifstream f{"../../d11/sample.txt"};
-    std::ifstream f{"../../d11/assignment.txt"};
+    // const util::mapped_file f{"../../d11/sample.txt"};
+    const util::mapped_file f{"../../d11/assignment.txt"};
 
-    const auto graph = parse_graph(f);
+    const auto graph = parse_graph(f.view());
     std::println("{}", graph);
 
-    std::println("Result: {}", count_paths(graph, graph.name_to_index.at("you"), graph.name_to_index.at("out")));
+    std::println("Result: {}", count_you_paths(graph));
 
     return 0;
 }
@@ -2,13 +2,15 @@
 #define AOC2025_MODEL_H
 
 #include <format>
-#include <fstream>
 #include <map>
 #include <ranges>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include <input.hpp>
+
 #include <lexy/action/parse.hpp>
 #include <lexy/callback.hpp>
 #include <lexy/dsl.hpp>
@@ -73,10 +75,10 @@ struct std::formatter<graph_struct> : std::formatter<char> {
     }
 };
 
-inline graph_struct parse_graph(std::istream &f) {
+inline graph_struct parse_graph(const std::string_view input) {
     const auto servers = [&] {
         std::vector<ast::server> tmp{};
-        for (std::string line; std::getline(f, line);)
+        for (const auto line: util::lines{input})
             tmp.emplace_back(lexy::parse<grammar::server>(lexy::string_input(line), lexy_ext::report_error).value());
         return tmp;
     }();
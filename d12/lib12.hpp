@@ -0,0 +1,87 @@
+#ifndef LIB12_HPP
+#define LIB12_HPP
+
+#include <algorithm>
+#include <format>
+#include <functional>
+#include <ranges>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <input.hpp>
+#include <vec.hpp>
+
+#include <lexy/action/parse.hpp>
+#include <lexy/input/string_input.hpp>
+#include <lexy_ext/report_error.hpp>
+
+#include "model.hpp"
+
+inline ast::file parse_tree_file(const std::string_view input) {
+    return lexy::parse<grammar::file>(lexy::string_input<lexy::utf8_encoding>(input.data(), input.size()),
+                                      lexy_ext::report_error)
+            .value();
+}
+
+/// total cells covered by the presents of a tree, regardless of their shape.
+inline int present_area(const ast::file &file, const ast::tree &tree) {
+    int total_count = 0;
+    for (int pr = 0; pr < file.presents.size(); ++pr)
+        total_count += tree.present_counts[pr] * file.presents[pr].cell_count();
+    return total_count;
+}
+
+enum class tree_fit {
+    /// the presents cover more cells than the tree has.
+    too_small,
+    /// every present gets a 3x3 block of its own.
+    trivially_fits,
+    /// needs an exact packing.
+    undecided,
+};
+
+/// sorts out trees where the presents can't possibly fit by area alone, or trivially fit as 3x3 blocks.
+inline tree_fit classify_tree(const ast::file &file, const ast::tree &tree) {
+    if (present_area(file, tree) > tree.w * tree.h) return tree_fit::too_small;
+    const int present_count = std::ranges::fold_left(tree.present_counts, 0, std::plus{});
+    if (present_count <= (tree.w / 3) * (tree.h / 3)) return tree_fit::trivially_fits;
+    return tree_fit::undecided;
+}
+
+struct tree_classification {
+    int skip_count;
+    int guarantee_count;
+    /// indices of trees which neither trivially fit nor trivially don't
+    std::vector<int> undecided;
+};
+
+inline tree_classification classify_trees(const ast::file &file) {
+    tree_classification result{};
+    for (int i_tree = 0; i_tree < file.trees.size(); ++i_tree) {
+        switch (classify_tree(file, file.trees[i_tree])) {
+            case tree_fit::too_small:
+                ++result.skip_count;
+                break;
+            case tree_fit::trivially_fits:
+                ++result.guarantee_count;
+                break;
+            case tree_fit::undecided:
+                result.undecided.push_back(i_tree);
+                break;
+        }
+    }
+    return result;
+}
+
+/// part 1: amount of trees that can fit all of their presents. The area bounds decide every tree of the assignment, so
+/// there's no packing solver behind this, and a tree they leave undecided is an error rather than a guess.
+inline int count_fitting_trees(const ast::file &file) {
+    const auto classification = classify_trees(file);
+    if (!classification.undecided.empty())
+        throw std::runtime_error(std::format("{} trees need an exact packing, starting with tree {}",
+                                             classification.undecided.size(), classification.undecided.front()));
+    return classification.guarantee_count;
+}
+
+#endif // LIB12_HPP
@@ -0,0 +1,335 @@
+#ifndef AOC2025_GENERATORS_HPP
+#define AOC2025_GENERATORS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "output.hpp"
+#include "random.hpp"
+
+namespace gen {
+/// every generator produces roughly `scale` times the size of the corresponding assignment.
+struct settings {
+    std::uint64_t scale{1};
+    /// line length for the days where that is a free dimension (d03, d04, d07)
+    std::optional<std::uint64_t> width{};
+};
+
+/// scales a two-dimensional assignment of `width` x `height` cells by `scale`, keeping the aspect ratio unless the
+/// width is given.
+inline std::pair<std::uint64_t, std::uint64_t> scaled_area(const settings &s, const std::uint64_t width,
+                                                            const std::uint64_t height) {
+    const auto area = width * height * s.scale;
+    const auto scaled_width = std::llround(static_cast<double>(width) * std::sqrt(static_cast<double>(s.scale)));
+    const auto w = s.width.value_or(static_cast<std::uint64_t>(scaled_width));
+    return {std::max<std::uint64_t>(w, 1), std::max<std::uint64_t>((area + w - 1) / w, 1)};
+}
+
+/// dial rotations, `L68` / `R48`, one per line.
+inline void generate_d01(output &out, random &rng, const settings &s) {
+    for (std::uint64_t i = 0; i < 4136 * s.scale; ++i)
+        out.print("{}{}\n", rng.chance(0.5) ? 'R' : 'L', rng.between(1, 999));
+}
+
+/// comma-separated `a-b` id ranges on a single line.
+inline void generate_d02(output &out, random &rng, const settings &s) {
+    for (std::uint64_t i = 0; i < 38 * s.scale; ++i) {
+        const auto digits = rng.between(1, 10);
+        const auto lo = static_cast<std::uint64_t>(std::pow(10, digits - 1));
+        const auto a = rng.between(lo, lo * 10 - 1);
+        const auto b = a + rng.between<std::uint64_t>(0, std::min<std::uint64_t>(lo, 200'000));
+        out.print("{}{}-{}", i == 0 ? "" : ",", a, b);
+    }
+    out.put('\n');
+}
+
+/// battery banks, lines of the digits 1-9.
+inline void generate_d03(output &out, random &rng, const settings &s) {
+    const auto width = s.width.value_or(100);
+    std::string line(width + 1, '\n');
+    for (std::uint64_t i = 0; i < 200 * s.scale; ++i) {
+        for (std::uint64_t col = 0; col < width; ++col)
+            line[col] = static_cast<char>('0' + rng.between(1, 9));
+        out.write(line);
+    }
+}
+
+/// paper roll map, `@` and `.`.
+inline void generate_d04(output &out, random &rng, const settings &s) {
+    const auto [width, height] = scaled_area(s, 139, 139);
+    std::string line(width + 1, '\n');
+    for (std::uint64_t row = 0; row < height; ++row) {
+        for (std::uint64_t col = 0; col < width; ++col)
+            line[col] = rng.chance(0.65) ? '@' : '.';
+        out.write(line);
+    }
+}
+
+/// overlapping `a-b` fresh id ranges, an empty line, then the available ids.
+inline void generate_d05(output &out, random &rng, const settings &s) {
+    constexpr std::uint64_t max_id = 562'949'953'421'312;
+    for (std::uint64_t i = 0; i < 180 * s.scale; ++i) {
+        const auto a = rng.between<std::uint64_t>(1, max_id);
+        out.print("{}-{}\n", a, a + rng.between<std::uint64_t>(0, 5'000'000'000'000));
+    }
+    out.put('\n');
+    for (std::uint64_t i = 0; i < 1000 * s.scale; ++i)
+        out.print("{}\n", rng.between<std::uint64_t>(1, max_id));
+}
+
+/// math worksheet: four rows of numbers, each problem one to four digits wide, and a row of operators below.
+inline void generate_d06(output &out, random &rng, const settings &s) {
+    constexpr int rows = 4;
+    const auto problem_count = 1000 * s.scale;
+    struct problem {
+        int width;
+        int widest_row;
+        bool left_aligned;
+    };
+    std::vector<problem> problems(problem_count);
+    for (auto &p: problems)
+        p = {.width = rng.between(1, 4), .widest_row = rng.between(0, rows - 1), .left_aligned = rng.chance(0.5)};
+    for (int row = 0; row < rows; ++row) {
+        for (std::uint64_t i = 0; i < problem_count; ++i) {
+            const auto &[width, widest_row, left_aligned] = problems[i];
+            // the widest number decides the width of the problem, the others are padded
+            const auto digits = row == widest_row ? width : rng.between(1, width);
+            const auto number = rng.between(digits == 1 ? 1 : static_cast<int>(std::pow(10, digits - 1)),
+                                            static_cast<int>(std::pow(10, digits)) - 1);
+            if (i != 0) out.put(' ');
+            if (left_aligned)
+                out.print("{:<{}}", number, width);
+            else
+                out.print("{:>{}}", number, width);
+        }
+        out.put('\n');
+    }
+    for (std::uint64_t p = 0; p < problem_count; ++p) {
+        const char op = rng.chance(0.5) ? '*' : '+';
+        if (p + 1 == problem_count)
+            out.put(op);
+        else
+            out.print("{:<{}}", op, problems[p].width + 1);
+    }
+    out.put('\n');
+}
+
+/// tachyon manifold: `S` in the top row, splitters `^` on every other row inside the cone the beam can reach.
+/// The amount of timelines grows exponentially with the height, so only the width is scaled: the height stays at the
+/// assignment's 142 rows, which keeps part 2 around 2^43 timelines, far from overflowing a long long.
+inline void generate_d07(output &out, random &rng, const settings &s) {
+    constexpr std::uint64_t height{142};
+    const auto width = s.width.value_or(141 * s.scale) | 1;
+    const auto start = static_cast<std::int64_t>(width / 2);
+    std::string line(width + 1, '\n');
+    for (std::uint64_t row = 0; row < height; ++row) {
+        std::fill_n(line.begin(), width, '.');
+        if (row == 0) line[start] = 'S';
+        const auto reach = static_cast<std::int64_t>(row / 2) - 1;
+        if (row % 2 == 0 && reach >= 0) {
+            for (auto offset = -reach; offset <= reach; offset += 2) {
+                const auto col = start + offset;
+                if (col >= 1 && col + 1 < static_cast<std::int64_t>(width) && rng.chance(0.67)) line[col] = '^';
+            }
+        }
+        out.write(line);
+    }
+}
+
+/// junction boxes, `x,y,z` per line.
+inline void generate_d08(output &out, random &rng, const settings &s) {
+    for (std::uint64_t i = 0; i < 1000 * s.scale; ++i)
+        out.print("{},{},{}\n", rng.between(0, 99'999), rng.between(0, 99'999), rng.between(0, 99'999));
+}
+
+/// red tiles, the vertices of a simple rectilinear polygon in order.
+/// The polygon is a band between a skyline above y=50000 and one below, so it can't intersect itself.
+inline void generate_d09(output &out, random &rng, const settings &s) {
+    const auto columns = 124 * s.scale;
+    std::vector<std::int64_t> xs(columns + 1), tops(columns), bottoms(columns);
+    xs[0] = rng.between(1, 1600);
+    for (std::uint64_t i = 1; i <= columns; ++i)
+        xs[i] = xs[i - 1] + rng.between(1, 1600);
+    for (std::uint64_t i = 0; i < columns; ++i) {
+        // neighboring heights differ, otherwise the shared vertex would be collinear
+        do tops[i] = rng.between(50'001, 99'999);
+        while (i != 0 && tops[i] == tops[i - 1]);
+        do bottoms[i] = rng.between(1, 49'999);
+        while (i != 0 && bottoms[i] == bottoms[i - 1]);
+    }
+    for (std::uint64_t i = 0; i < columns; ++i)
+        out.print("{},{}\n{},{}\n", xs[i], tops[i], xs[i + 1], tops[i]);
+    for (auto i = columns; i-- > 0;)
+        out.print("{},{}\n{},{}\n", xs[i + 1], bottoms[i], xs[i], bottoms[i]);
+}
+
+/// machines: indicator lights, buttons and joltage requirements. Targets are built from random presses, so every
+/// machine is solvable.
+inline void generate_d10(output &out, random &rng, const settings &s) {
+    for (std::uint64_t i = 0; i < 198 * s.scale; ++i) {
+        const auto light_count = rng.between(4, 10);
+        const auto button_count = rng.between(light_count - 1, std::min(light_count + 3, 13));
+        std::vector<std::vector<int>> buttons(button_count);
+        for (auto &button: buttons) {
+            for (int l = 0; l < light_count; ++l)
+                if (rng.chance(0.4)) button.push_back(l);
+            if (button.empty()) button.push_back(rng.between(0, light_count - 1));
+        }
+        std::vector joltages(light_count, 0);
+        for (const auto &button: buttons) {
+            const auto presses = rng.between(0, 20);
+            for (const int l: button)
+                joltages[l] += presses;
+        }
+        std::vector lights(light_count, false);
+        for (const auto &button: buttons)
+            if (rng.chance(0.5))
+                for (const int l: button)
+                    lights[l] = !lights[l];
+
+        out.put('[');
+        for (const bool on: lights)
+            out.put(on ? '#' : '.');
+        out.put(']');
+        for (const auto &button: buttons) {
+            out.write(" (");
+            for (std::size_t b = 0; b < button.size(); ++b)
+                out.print("{}{}", b == 0 ? "" : ",", button[b]);
+            out.put(')');
+        }
+        out.write(" {");
+        for (int l = 0; l < light_count; ++l)
+            out.print("{}{}", l == 0 ? "" : ",", joltages[l]);
+        out.write("}\n");
+    }
+}
+
+/// server names are letters only, at least three of them.
+inline std::string server_name(std::uint64_t index) {
+    std::size_t length = 3;
+    for (std::uint64_t count = 26 * 26 * 26; index >= count; count *= 26) {
+        index -= count;
+        ++length;
+    }
+    std::string name(length, 'a');
+    for (auto it = name.rbegin(); it != name.rend(); ++it, index /= 26)
+        *it = static_cast<char>('a' + index % 26);
+    return name;
+}
+
+/// server rack: a layered DAG from `svr` to `out` which passes through `fft` and `dac`, with `you` in between.
+inline void generate_d11(output &out, random &rng, const settings &s) {
+    constexpr int layer_count = 20;
+    const auto layer_width = 33 * s.scale;
+    constexpr std::array<std::string_view, 5> reserved{"svr", "you", "fft", "dac", "out"};
+
+    std::vector<std::string> names{};
+    for (std::uint64_t next = 0; names.size() < layer_count * layer_width; ++next)
+        if (auto name = server_name(next); std::ranges::find(reserved, name) == reserved.end())
+            names.emplace_back(std::move(name));
+    // layer l occupies names[l * layer_width, (l + 1) * layer_width), its first node is part of the guaranteed path
+    names[0] = "svr";
+    names[3 * layer_width + 1] = "you";
+    names[6 * layer_width] = "fft";
+    names[13 * layer_width] = "dac";
+
+    std::vector<std::string> lines{};
+    for (int layer = 0; layer < layer_count; ++layer) {
+        for (std::uint64_t i = 0; i < layer_width; ++i) {
+            std::string line = names[layer * layer_width + i] + ":";
+            if (layer + 1 == layer_count) {
+                line += " out";
+            } else {
+                std::vector<std::uint64_t> targets{};
+                if (i == 0) targets.push_back(0);
+                const std::size_t degree = rng.chance(0.5) ? 1 : rng.chance(0.8) ? 2 : 3;
+                while (targets.size() < degree)
+                    if (const auto t = rng.between<std::uint64_t>(0, layer_width - 1);
+                        std::ranges::find(targets, t) == targets.end())
+                        targets.push_back(t);
+                for (const auto t: targets)
+                    line += " " + names[(layer + 1) * layer_width + t];
+            }
+            lines.emplace_back(std::move(line));
+        }
+    }
+    rng.shuffle(lines);
+    for (const auto &line: lines)
+        out.print("{}\n", line);
+}
+
+/// six 3x3 presents, then trees which either trivially fit their presents or trivially don't.
+inline void generate_d12(output &out, random &rng, const settings &s) {
+    constexpr int present_count = 6;
+    std::array<int, present_count> cell_counts{};
+    for (int p = 0; p < present_count; ++p) {
+        std::array<bool, 9> cells{};
+        while (std::ranges::count(cells, true) < 5 || std::ranges::count(cells, true) > 7)
+            for (auto &&c: cells)
+                c = rng.chance(0.7);
+        cell_counts[p] = static_cast<int>(std::ranges::count(cells, true));
+        out.print("{}:\n", p);
+        for (int y = 0; y < 3; ++y)
+            out.print("{}{}{}\n", cells[y * 3] ? '#' : '.', cells[y * 3 + 1] ? '#' : '.', cells[y * 3 + 2] ? '#' : '.');
+        out.put('\n');
+    }
+    for (std::uint64_t i = 0; i < 1000 * s.scale; ++i) {
+        const auto w = rng.between(35, 50);
+        const auto h = rng.between(35, 50);
+        std::array<int, present_count> counts{};
+        const auto blocks = (w / 3) * (h / 3);
+        for (int placed = rng.between(blocks * 3 / 4, blocks); placed > 0; --placed)
+            ++counts[rng.between(0, present_count - 1)];
+        if (rng.chance(0.5)) {
+            // overfill until the cells alone exceed the area
+            auto cells = std::inner_product(counts.begin(), counts.end(), cell_counts.begin(), 0);
+            while (cells <= w * h) {
+                const auto p = rng.between(0, present_count - 1);
+                ++counts[p];
+                cells += cell_counts[p];
+            }
+        }
+        out.print("{}x{}:", w, h);
+        for (const int c: counts)
+            out.print(" {}", c);
+        out.put('\n');
+    }
+}
+struct generator {
+    int day;
+    void (*generate)(output &, random &, const settings &);
+};
+
+inline constexpr std::array generators{
+        generator{1, generate_d01},  generator{2, generate_d02},  generator{3, generate_d03},
+        generator{4, generate_d04},  generator{5, generate_d05},  generator{6, generate_d06},
+        generator{7, generate_d07},  generator{8, generate_d08},  generator{9, generate_d09},
+        generator{10, generate_d10}, generator{11, generate_d11}, generator{12, generate_d12},
+};
+
+/// generates a whole input in memory.
+inline std::string generate(const int day, const std::uint64_t seed, const settings &s) {
+    const auto it = std::ranges::find(generators, day, &generator::day);
+    if (it == generators.end()) throw std::invalid_argument(std::format("no generator for day {}", day));
+    std::string result{};
+    random rng{seed};
+    {
+        output out{result};
+        it->generate(out, rng, s);
+        out.flush();
+    }
+    return result;
+}
+} // namespace gen
+
+#endif // AOC2025_GENERATORS_HPP
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <format>
+#include <optional>
+#include <print>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "generators.hpp"
+
+struct options {
+    const gen::generator *day{nullptr};
+    gen::settings settings{};
+    std::uint64_t seed{0};
+    std::optional<std::string> output{};
+};
+
+std::uint64_t parse_uint(const std::string_view flag, const std::string_view value) {
+    std::uint64_t result;
+    if (const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+        ec != std::errc{} || ptr != value.data() + value.size())
+        throw std::invalid_argument(std::format("{} expects a non-negative integer, got '{}'", flag, value));
+    return result;
+}
+
+options parse_options(const std::span<char *> args) {
+    if (args.empty()) throw std::invalid_argument("missing day");
+    options result{};
+    const std::string_view day{args.front()};
+    const auto matches_day = [&](const gen::generator &g) { return std::format("d{:02}", g.day) == day; };
+    if (const auto it = std::ranges::find_if(gen::generators, matches_day); it != gen::generators.end())
+        result.day = &*it;
+    else
+        throw std::invalid_argument(std::format("unknown day '{}'", day));
+
+    for (auto it = args.begin() + 1; it != args.end(); ++it) {
+        const std::string_view flag{*it};
+        if (it + 1 == args.end()) throw std::invalid_argument(std::format("{} expects a value", flag));
+        const std::string_view value{*++it};
+        if (flag == "--scale")
+            result.settings.scale = parse_uint(flag, value);
+        else if (flag == "--seed")
+            result.seed = parse_uint(flag, value);
+        else if (flag == "--width")
+            result.settings.width = parse_uint(flag, value);
+        else if (flag == "--output")
+            result.output = std::string{value};
+        else
+            throw std::invalid_argument(std::format("unknown flag {}", flag));
+    }
+    if (result.settings.scale < 1) throw std::invalid_argument("--scale must be at least 1");
+    if (result.settings.width == 0u) throw std::invalid_argument("--width must be at least 1");
+    return result;
+}
+
+void print_usage() {
+    std::println("Usage: aoc_gen dNN [--scale N] [--seed S] [--width W] [--output FILE]");
+    std::println("  dNN            the day to generate an input for, d01 to d12");
+    std::println("  --scale N      generate roughly N times the size of the assignment (default: 1)");
+    std::println("  --seed S       the same seed always produces the same input (default: 0)");
+    std::println("  --width W      line length for d03, d04 and d07, the height is scaled to match");
+    std::println("  --output FILE  write to FILE instead of stdout");
+}
+
+int main(const int argc, char **argv) {
+    options opts;
+    try {
+        opts = parse_options({argv + 1, argv + argc});
+    } catch (const std::invalid_argument &e) {
+        std::println(stderr, "{}", e.what());
+        print_usage();
+        return 1;
+    }
+
+    std::FILE *file = stdout;
+    if (opts.output) {
+        file = std::fopen(opts.output->c_str(), "wb");
+        if (!file) {
+            std::println(stderr, "can't open {}", *opts.output);
+            return 1;
+        }
+    }
+    try {
+        gen::random rng{opts.seed};
+        gen::output out{file};
+        opts.day->generate(out, rng, opts.settings);
+        out.flush();
+    } catch (const std::exception &e) {
+        std::println(stderr, "{}", e.what());
+        return 1;
+    }
+    if (file != stdout) std::fclose(file);
+    return 0;
+}
@@ -0,0 +1,63 @@
+#ifndef AOC2025_OUTPUT_HPP
+#define AOC2025_OUTPUT_HPP
+
+#include <cstdio>
+#include <format>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace gen {
+/// collects formatted output and hands it to the file in large blocks, so multi-GB inputs don't go through stdio
+/// one line at a time. Alternatively, everything can be collected in a string instead.
+class output {
+    static constexpr std::size_t flush_threshold = 1 << 20;
+
+    std::FILE *file;
+    std::string *target;
+    std::string buffer{};
+
+public:
+    explicit output(std::FILE *file) : file{file}, target{nullptr} { buffer.reserve(flush_threshold + 4096); }
+
+    explicit output(std::string &target) : file{nullptr}, target{&target} { buffer.reserve(flush_threshold + 4096); }
+
+    output(const output &) = delete;
+    output &operator=(const output &) = delete;
+
+    ~output() {
+        if (buffer.empty()) return;
+        if (target)
+            target->append(buffer);
+        else
+            std::fwrite(buffer.data(), 1, buffer.size(), file);
+    }
+
+    template<typename... Args>
+    void print(std::format_string<Args...> fmt, Args &&...args) {
+        std::format_to(std::back_inserter(buffer), fmt, std::forward<Args>(args)...);
+        if (buffer.size() >= flush_threshold) flush();
+    }
+
+    void put(const char c) {
+        buffer.push_back(c);
+        if (buffer.size() >= flush_threshold) flush();
+    }
+
+    void write(const std::string_view s) {
+        buffer.append(s);
+        if (buffer.size() >= flush_threshold) flush();
+    }
+
+    void flush() {
+        if (target)
+            target->append(buffer);
+        else if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+            throw std::runtime_error("failed to write output");
+        buffer.clear();
+    }
+};
+} // namespace gen
+
+#endif // AOC2025_OUTPUT_HPP
@@ -0,0 +1,43 @@
+#ifndef AOC2025_RANDOM_HPP
+#define AOC2025_RANDOM_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gen {
+/// splitmix64. The standard distributions are implementation-defined, so the generators only use this, which produces
+/// the same stream for a given seed on every platform.
+class random {
+    std::uint64_t state;
+
+public:
+    explicit constexpr random(const std::uint64_t seed) noexcept : state{seed} {}
+
+    constexpr std::uint64_t next() noexcept {
+        std::uint64_t z = state += 0x9e3779b97f4a7c15ull;
+        z = (z ^ z >> 30) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ z >> 27) * 0x94d049bb133111ebull;
+        return z ^ z >> 31;
+    }
+
+    /// uniform in [lo; hi], the modulo bias is irrelevant for input generation.
+    template<typename T>
+    constexpr T between(const T lo, const T hi) noexcept {
+        const auto span = static_cast<std::uint64_t>(hi) - static_cast<std::uint64_t>(lo) + 1;
+        if (span == 0) return static_cast<T>(next());
+        return static_cast<T>(static_cast<std::uint64_t>(lo) + next() % span);
+    }
+
+    /// true with probability `p`.
+    constexpr bool chance(const double p) noexcept { return static_cast<double>(next() >> 11) * 0x1.0p-53 < p; }
+
+    template<typename T>
+    constexpr void shuffle(std::vector<T> &v) noexcept {
+        for (auto i = v.size(); i > 1; --i)
+            std::swap(v[i - 1], v[between<std::size_t>(0, i - 1)]);
+    }
+};
+} // namespace gen
+
+#endif // AOC2025_RANDOM_HPP
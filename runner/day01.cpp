@@ -0,0 +1,13 @@
+#include "days.hpp"
+
+#include <array>
+
+#include "../d01/lib01.hpp"
+
+std::span<const aoc::part_entry> aoc::day01() {
+    static constexpr std::array parts{
+            part_entry{1, 1, run_part<parse_rotations, count_zeros_parallel<false>>},
+            part_entry{1, 2, run_part<parse_rotations, count_zeros_parallel<true>>},
+    };
+    return parts;
+}
@@ -0,0 +1,13 @@
+#include "days.hpp"
+
+#include <array>
+
+#include "../d02/lib02.hpp"
+
+std::span<const aoc::part_entry> aoc::day02() {
+    static constexpr std::array parts{
+            part_entry{2, 1, run_part<parse_product_ranges, sum_ranges<sum_doubled_ids>>},
+            part_entry{2, 2, run_part<parse_product_ranges, sum_ranges<sum_repeated_ids>>},
+    };
+    return parts;
+}
@@ -0,0 +1,13 @@
+#include "days.hpp"
+
+#include <array>
+
+#include "../d03/lib03.hpp"
+
+std::span<const aoc::part_entry> aoc::day03() {
+    static constexpr std::array parts{
+            part_entry{3, 1, run_part<parse_banks, total_joltage<2>>},
+            part_entry{3, 2, run_part<parse_banks, total_joltage<12>>},
+    };
+    return parts;
+}
@@ -0,0 +1,13 @@
+#include "days.hpp"
+
+#include <array>
+
+#include "../d04/lib04.hpp"
+
+std::span<const aoc::part_entry> aoc::day04() {
+    static constexpr std::array parts{
+            part_entry{4, 1, run_part<parse_grid, count_accessible>},
+            part_entry{4, 2, run_part<parse_grid, count_removed_incremental>},
+    };
+    return parts;
+}
@@ -0,0 +1,13 @@
+#include "days.hpp"
+
+#include <array>
+
+#include "../d05/lib06.hpp"
+
+std::span<const aoc::part_entry> aoc::day05() {
+    static constexpr std::array parts{
+            part_entry{5, 1, run_part<parse_inventory, count_fresh>},
+            part_entry{5, 2, run_part<parse_ranges, count_fresh_ids>},
+    };
+    return parts;
+}
@@ -0,0 +1,18 @@
+#include "days.hpp"
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+#include "../d06/lib06.hpp"
+
+std::span<const aoc::part_entry> aoc::day06() {
+    static constexpr auto vertical_grand_total = [](const std::vector<std::string_view> &lines) {
+        return vertical_grand_total_tiled(lines);
+    };
+    static constexpr std::array parts{
+            part_entry{6, 1, run_part<parse_worksheet, grand_total>},
+            part_entry{6, 2, run_part<parse_lines, vertical_grand_total>},
+    };
+    return parts;
+}
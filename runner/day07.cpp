@@ -0,0 +1,15 @@
+#include "days.hpp"
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+#include "../d07/lib07.hpp"
+
+std::span<const aoc::part_entry> aoc::day07() {
+    static constexpr std::array parts{
+            part_entry{7, 1, run_part<parse_manifold, count_splits_bitset<std::vector<std::string_view>>>},
+            part_entry{7, 2, run_part<parse_manifold, count_timelines_rolling<std::vector<std::string_view>>>},
+    };
+    return parts;
+}
@@ -0,0 +1,20 @@
+#include "days.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "../d08/lib08.hpp"
+
+std::span<const aoc::part_entry> aoc::day08() {
+    // the assignment connects its 1000 closest pairs. The sample would only connect 10, which isn't distinguished here.
+    static constexpr auto largest_circuits = [](const std::vector<box> &boxes) {
+        const auto pair_count = boxes.size() * (boxes.size() - 1) / 2;
+        return largest_circuits_product_indexed(boxes, static_cast<int>(std::min<std::size_t>(1000, pair_count)));
+    };
+    static constexpr std::array parts{
+            part_entry{8, 1, run_part<parse_boxes, largest_circuits>},
+            part_entry{8, 2, run_part<parse_boxes, last_connection_product_emst>},
+    };
+    return parts;
+}
@@ -0,0 +1,16 @@
+#include "days.hpp"
+
+#include <array>
+
+#include "../d09/lib09.hpp"
+
+std::span<const aoc::part_entry> aoc::day09() {
+    static constexpr auto largest_enclosed_area = [](const std::vector<int2> &coords) {
+        return largest_enclosed_rectangle(coords).area;
+    };
+    static constexpr std::array parts{
+            part_entry{9, 1, run_part<parse_tiles, largest_rectangle>},
+            part_entry{9, 2, run_part<parse_tiles, largest_enclosed_area>},
+    };
+    return parts;
+}
@@ -0,0 +1,13 @@
+#include "days.hpp"
+
+#include <array>
+
+#include "../d10/milp.hpp"
+
+std::span<const aoc::part_entry> aoc::day10() {
+    static constexpr std::array parts{
+            part_entry{10, 1, run_part<parse_machines, total_light_presses>},
+            part_entry{10, 2, run_part<parse_machines, total_joltage_presses<>>},
+    };
+    return parts;
+}
@@ -0,0 +1,13 @@
+#include "days.hpp"
+
+#include <array>
+
+#include "../d11/lib11.hpp"
+
+std::span<const aoc::part_entry> aoc::day11() {
+    static constexpr std::array parts{
+            part_entry{11, 1, run_part<parse_graph, count_you_paths>},
+            part_entry{11, 2, run_part<parse_graph, count_server_paths>},
+    };
+    return parts;
+}
@@ -0,0 +1,12 @@
+#include "days.hpp"
+
+#include <array>
+
+#include "../d12/lib12.hpp"
+
+std::span<const aoc::part_entry> aoc::day12() {
+    static constexpr std::array parts{
+            part_entry{12, 1, run_part<parse_tree_file, count_fitting_trees>},
+    };
+    return parts;
+}
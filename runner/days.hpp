@@ -0,0 +1,60 @@
+#ifndef AOC2025_DAYS_HPP
+#define AOC2025_DAYS_HPP
+
+#include <chrono>
+#include <format>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc {
+struct part_result {
+    std::string answer;
+    std::chrono::steady_clock::duration parse_time;
+    std::chrono::steady_clock::duration solve_time;
+};
+
+/// a single part solver, given the whole input. Parsing and solving are timed separately, formatting the answer isn't
+/// timed at all.
+struct part_entry {
+    int day;
+    int part;
+    part_result (*run)(std::string_view);
+};
+
+template<auto Parse, auto Solve>
+part_result run_part(const std::string_view text) {
+    const auto parse_start = std::chrono::steady_clock::now();
+    const auto input = Parse(text);
+    const auto solve_start = std::chrono::steady_clock::now();
+    const auto answer = Solve(input);
+    const auto solve_end = std::chrono::steady_clock::now();
+    return {.answer = std::format("{}", answer),
+            .parse_time = solve_start - parse_start,
+            .solve_time = solve_end - solve_start};
+}
+
+// every day lives in its own translation unit, as the days reuse type and function names.
+std::span<const part_entry> day01();
+std::span<const part_entry> day02();
+std::span<const part_entry> day03();
+std::span<const part_entry> day04();
+std::span<const part_entry> day05();
+std::span<const part_entry> day06();
+std::span<const part_entry> day07();
+std::span<const part_entry> day08();
+std::span<const part_entry> day09();
+std::span<const part_entry> day10();
+std::span<const part_entry> day11();
+std::span<const part_entry> day12();
+
+inline std::vector<part_entry> all_parts() {
+    std::vector<part_entry> parts{};
+    for (const auto day: {day01, day02, day03, day04, day05, day06, day07, day08, day09, day10, day11, day12})
+        parts.append_range(day());
+    return parts;
+}
+} // namespace aoc
+
+#endif // AOC2025_DAYS_HPP
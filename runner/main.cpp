@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <optional>
+#include <print>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <input.hpp>
+
+#include "days.hpp"
+#include "process.hpp"
+
+using milliseconds = std::chrono::duration<double, std::milli>;
+
+struct options {
+    bool help{false};
+    std::optional<int> day;
+    std::optional<int> part;
+    std::optional<std::string> input;
+    int repeat{1};
+};
+
+int parse_int(const std::string_view flag, const std::string_view value) {
+    int result;
+    if (const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+        ec != std::errc{} || ptr != value.data() + value.size())
+        throw std::invalid_argument(std::format("{} expects an integer, got '{}'", flag, value));
+    return result;
+}
+
+options parse_options(const std::span<char *> args) {
+    options result{};
+    for (auto it = args.begin(); it != args.end(); ++it) {
+        const std::string_view flag{*it};
+        if (flag == "--help" || flag == "-h") {
+            result.help = true;
+            continue;
+        }
+        if (it + 1 == args.end()) throw std::invalid_argument(std::format("{} expects a value", flag));
+        const std::string_view value{*++it};
+        if (flag == "--day")
+            result.day = parse_int(flag, value);
+        else if (flag == "--part")
+            result.part = parse_int(flag, value);
+        else if (flag == "--input")
+            result.input = std::string{value};
+        else if (flag == "--repeat")
+            result.repeat = parse_int(flag, value);
+        else
+            throw std::invalid_argument(std::format("unknown flag {}", flag));
+    }
+    if (result.input && !result.day) throw std::invalid_argument("--input requires --day");
+    if (result.repeat < 1) throw std::invalid_argument("--repeat must be at least 1");
+    return result;
+}
+
+void print_usage() {
+    std::println("Usage: aoc [--day N] [--part P] [--input FILE] [--repeat N]");
+    std::println("  --day N       only run day N (default: every day)");
+    std::println("  --part P      only run part P (default: every part)");
+    std::println("  --input FILE  read FILE instead of dNN/assignment.txt, requires --day");
+    std::println("  --repeat N    run every part N times, reporting the best and mean times (default: 1)");
+}
+
+void run(const aoc::part_entry &entry, const std::string &path, const int repeat) {
+    std::string answer{};
+    auto best_parse = std::chrono::steady_clock::duration::max();
+    auto best_solve = std::chrono::steady_clock::duration::max();
+    std::chrono::steady_clock::duration total_parse{}, total_solve{};
+    // without a reset, the peak is the one of every part run so far.
+    const auto peak_of_part = aoc::reset_peak_rss();
+    for (int i = 0; i < repeat; ++i) {
+        const util::mapped_file f{path};
+        auto [result, parse_time, solve_time] = entry.run(f.view());
+        if (i != 0 && result != answer)
+            throw std::runtime_error(std::format("day {:02} part {} is not deterministic: {} != {}", entry.day,
+                                                 entry.part, result, answer));
+        answer = std::move(result);
+        best_parse = std::min(best_parse, parse_time);
+        best_solve = std::min(best_solve, solve_time);
+        total_parse += parse_time;
+        total_solve += solve_time;
+    }
+    const auto peak_rss = static_cast<double>(aoc::peak_rss_bytes()) / (1024 * 1024);
+    std::println("day {:02} part {}: {:>20} | parse {:10.3f} ms | solve {:10.3f} ms | {:>7} peak rss {:8.1f} MiB",
+                 entry.day, entry.part, answer, milliseconds{best_parse}.count(), milliseconds{best_solve}.count(),
+                 peak_of_part ? "part" : "process", peak_rss);
+    if (repeat > 1)
+        std::println("{:>35} | mean  {:10.3f} ms | mean  {:10.3f} ms |", "", milliseconds{total_parse / repeat}.count(),
+                     milliseconds{total_solve / repeat}.count());
+}
+
+int main(const int argc, char **argv) {
+    options opts;
+    try {
+        opts = parse_options({argv + 1, argv + argc});
+    } catch (const std::invalid_argument &e) {
+        std::println(stderr, "{}", e.what());
+        print_usage();
+        return 1;
+    }
+    if (opts.help) {
+        print_usage();
+        return 0;
+    }
+
+    auto ran_any = false;
+    for (const auto &entry: aoc::all_parts()) {
+        if (opts.day && entry.day != *opts.day) continue;
+        if (opts.part && entry.part != *opts.part) continue;
+        const auto path = opts.input.value_or(std::format("{}/d{:02}/assignment.txt", AOC_SOURCE_DIR, entry.day));
+        try {
+            run(entry, path, opts.repeat);
+        } catch (const std::exception &e) {
+            std::println(stderr, "day {:02} part {} failed: {}", entry.day, entry.part, e.what());
+            return 1;
+        }
+        ran_any = true;
+    }
+    if (!ran_any) {
+        std::println(stderr, "no part matches the given --day/--part");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#ifndef AOC2025_PROCESS_HPP
+#define AOC2025_PROCESS_HPP
+
+#include <cstddef>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+#ifdef __linux__
+#include <fstream>
+#include <string>
+#endif
+
+namespace aoc {
+/// starts a new high-water mark for `peak_rss_bytes`, if the platform allows it. Linux does when /proc/self/clear_refs
+/// is writable, elsewhere the peak stays the one of the whole process.
+/// @return whether the mark was reset, i.e. whether the next peak only covers what runs from here on.
+inline bool reset_peak_rss() {
+#ifdef __linux__
+    std::ofstream clear_refs{"/proc/self/clear_refs"};
+    // 5 resets the peak resident set size of the process.
+    return clear_refs << "5" && clear_refs.flush();
+#else
+    return false;
+#endif
+}
+
+/// high-water mark of the resident set of this process, in bytes, since the start or the last `reset_peak_rss`.
+inline std::size_t peak_rss_bytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return counters.PeakWorkingSetSize;
+#else
+#ifdef __linux__
+    // unlike ru_maxrss, VmHWM follows the resets.
+    std::ifstream status{"/proc/self/status"};
+    for (std::string line; std::getline(status, line);)
+        if (line.starts_with("VmHWM:")) return std::stoull(line.substr(6)) * 1024;
+#endif
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+    // linux reports kilobytes
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+} // namespace aoc
+
+#endif // AOC2025_PROCESS_HPP
@@ -0,0 +1,262 @@
+#ifndef AOC2025_INPUT_H
+#define AOC2025_INPUT_H
+
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace util {
+/// read-only memory mapping of an entire file. The contents are only paged in once they are accessed.
+class mapped_file {
+    const char *data{nullptr};
+    std::size_t size{0};
+#ifdef _WIN32
+    HANDLE mapping{nullptr};
+#endif
+
+public:
+    explicit mapped_file(const std::string &path) {
+#ifdef _WIN32
+        const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) throw std::runtime_error(std::format("can't open {}", path));
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(file, &file_size)) {
+            CloseHandle(file);
+            throw std::runtime_error(std::format("can't stat {}", path));
+        }
+        size = static_cast<std::size_t>(file_size.QuadPart);
+        if (size != 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+        CloseHandle(file);
+        if (size != 0 && !data) {
+            if (mapping) CloseHandle(mapping);
+            throw std::runtime_error(std::format("can't map {}", path));
+        }
+#else
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) throw std::runtime_error(std::format("can't open {}", path));
+        struct stat st{};
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            throw std::runtime_error(std::format("can't stat {}", path));
+        }
+        size = static_cast<std::size_t>(st.st_size);
+        if (size != 0) {
+            void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error(std::format("can't map {}", path));
+            }
+            madvise(p, size, MADV_SEQUENTIAL);
+            data = static_cast<const char *>(p);
+        }
+        close(fd);
+#endif
+    }
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    mapped_file(mapped_file &&other) noexcept :
+        data{std::exchange(other.data, nullptr)}, size{std::exchange(other.size, 0)} {
+#ifdef _WIN32
+        mapping = std::exchange(other.mapping, nullptr);
+#endif
+    }
+
+    mapped_file &operator=(mapped_file &&other) noexcept {
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+#ifdef _WIN32
+        std::swap(mapping, other.mapping);
+#endif
+        return *this;
+    }
+
+    ~mapped_file() {
+        if (!data) return;
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle(mapping);
+#else
+        munmap(const_cast<char *>(data), size);
+#endif
+    }
+
+    [[nodiscard]] std::string_view view() const { return {data, size}; }
+};
+
+/// first '\n' in [begin; end), or end. Compares 32 (AVX2) or 16 (SSE2) bytes at a time where available.
+inline const char *find_newline(const char *begin, const char *const end) noexcept {
+#ifdef __AVX2__
+    const __m256i newline32 = _mm256_set1_epi8('\n');
+    for (; end - begin >= 32; begin += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+        if (const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline32))))
+            return begin + std::countr_zero(mask);
+    }
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i newline16 = _mm_set1_epi8('\n');
+    for (; end - begin >= 16; begin += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline16))))
+            return begin + std::countr_zero(mask);
+    }
+#endif
+    for (; begin != end; ++begin)
+        if (*begin == '\n') return begin;
+    return end;
+}
+
+/// splits the input like repeated std::getline would: a trailing '\r' is dropped, and a trailing newline doesn't
+/// produce an empty last line.
+class lines {
+    std::string_view input;
+
+public:
+    class iterator {
+        const char *pos{nullptr}, *end{nullptr};
+        std::string_view current{};
+
+        void read_line() {
+            const char *const newline = find_newline(pos, end);
+            current = {pos, static_cast<std::size_t>(newline - pos)};
+            if (current.ends_with('\r')) current.remove_suffix(1);
+            pos = newline == end ? nullptr : newline + 1;
+        }
+
+    public:
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        explicit iterator(const std::string_view input) : pos{input.data()}, end{input.data() + input.size()} {
+            if (input.empty())
+                pos = end = nullptr;
+            else
+                read_line();
+        }
+
+        [[nodiscard]] std::string_view operator*() const { return current; }
+
+        iterator &operator++() {
+            if (pos == nullptr || pos == end)
+                pos = end = nullptr;
+            else
+                read_line();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            const iterator copy{*this};
+            ++*this;
+            return copy;
+        }
+
+        [[nodiscard]] bool operator==(const iterator &other) const { return pos == other.pos && end == other.end; }
+    };
+
+    explicit constexpr lines(const std::string_view input) : input{input} {}
+
+    [[nodiscard]] iterator begin() const { return iterator{input}; }
+    [[nodiscard]] static iterator end() { return {}; }
+};
+
+static_assert(std::forward_iterator<lines::iterator>);
+
+/// cuts the input into blocks of roughly `block_size` bytes that each end after a newline, so every line lies entirely
+/// inside one block. Meant for handing whole blocks of lines to different threads.
+inline std::vector<std::string_view> line_blocks(const std::string_view input, const std::size_t block_size) {
+    std::vector<std::string_view> blocks{};
+    const char *begin = input.data();
+    const char *const end = input.data() + input.size();
+    while (begin != end) {
+        const char *block_end = end;
+        if (static_cast<std::size_t>(end - begin) > block_size) {
+            block_end = find_newline(begin + block_size, end);
+            if (block_end != end) ++block_end;
+        }
+        blocks.emplace_back(begin, static_cast<std::size_t>(block_end - begin));
+        begin = block_end;
+    }
+    return blocks;
+}
+
+/// zero-copy replacement for `f >> a >> comma >> b` style parsing. Every read skips leading whitespace, like an
+/// istream does, and leaves the position untouched if it fails.
+class scanner {
+    const char *pos;
+    const char *end;
+
+    static constexpr bool is_space(const char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+public:
+    explicit constexpr scanner(const std::string_view input) : pos{input.data()}, end{input.data() + input.size()} {}
+
+    [[nodiscard]] constexpr bool at_end() const { return pos == end; }
+
+    [[nodiscard]] constexpr std::string_view rest() const { return {pos, static_cast<std::size_t>(end - pos)}; }
+
+    constexpr void skip_whitespace() {
+        while (pos != end && is_space(*pos))
+            ++pos;
+    }
+
+    template<std::integral T>
+    bool read(T &value) {
+        skip_whitespace();
+        const auto [ptr, ec] = std::from_chars(pos, end, value);
+        if (ec != std::errc{}) return false;
+        pos = ptr;
+        return true;
+    }
+
+    bool read(char &c) {
+        skip_whitespace();
+        if (pos == end) return false;
+        c = *pos++;
+        return true;
+    }
+
+    /// the rest of the current line, without skipping whitespace first.
+    bool read_line(std::string_view &line) {
+        if (pos == end) return false;
+        const char *const newline = find_newline(pos, end);
+        line = {pos, static_cast<std::size_t>(newline - pos)};
+        if (line.ends_with('\r')) line.remove_suffix(1);
+        pos = newline == end ? end : newline + 1;
+        return true;
+    }
+};
+} // namespace util
+
+#endif // AOC2025_INPUT_H
@@ -0,0 +1,278 @@
+#ifndef AOC2025_PARALLEL_H
+#define AOC2025_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace util {
+/// every worker owns a deque of tasks. It pushes and pops at the back, while idle workers steal from the front of the
+/// other deques, so the oldest (and usually biggest) chunks of work are the ones that move between threads.
+class thread_pool {
+    using task = std::move_only_function<void()>;
+
+    struct worker_queue {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    std::vector<std::unique_ptr<worker_queue>> queues;
+    std::atomic<std::size_t> pending{0};
+    std::atomic<std::size_t> next_queue{0};
+    std::mutex sleep_mutex;
+    std::condition_variable_any wake;
+    // declared last, so the workers are joined before the queues they work on are destroyed.
+    std::vector<std::jthread> workers;
+
+    inline static thread_local const thread_pool *current_pool{nullptr};
+    inline static thread_local std::size_t current_index{0};
+
+    std::optional<task> pop(const std::size_t index, const bool back) {
+        auto &[mutex, tasks] = *queues[index];
+        const std::scoped_lock lock{mutex};
+        if (tasks.empty()) return std::nullopt;
+        std::optional<task> result;
+        if (back) {
+            result.emplace(std::move(tasks.back()));
+            tasks.pop_back();
+        } else {
+            result.emplace(std::move(tasks.front()));
+            tasks.pop_front();
+        }
+        pending.fetch_sub(1, std::memory_order_relaxed);
+        return result;
+    }
+
+    /// own queue first, then steal from everybody else.
+    std::optional<task> find_task() {
+        const auto own = current_pool == this ? std::optional{current_index} : std::nullopt;
+        if (own)
+            if (auto t = pop(*own, true)) return t;
+        const auto start = own.value_or(next_queue.load(std::memory_order_relaxed));
+        for (std::size_t i = 1; i <= queues.size(); ++i)
+            if (auto t = pop((start + i) % queues.size(), false)) return t;
+        return std::nullopt;
+    }
+
+    void work(const std::stop_token &stop, const std::size_t index) {
+        current_pool = this;
+        current_index = index;
+        while (!stop.stop_requested()) {
+            if (auto t = find_task()) {
+                (*t)();
+                continue;
+            }
+            std::unique_lock lock{sleep_mutex};
+            wake.wait(lock, stop, [&] { return pending.load(std::memory_order_relaxed) != 0; });
+        }
+    }
+
+public:
+    /// amount of threads from the AOC_THREADS environment variable, or the hardware concurrency.
+    [[nodiscard]] static unsigned default_thread_count() {
+        if (const char *env = std::getenv("AOC_THREADS")) {
+            const std::string_view value{env};
+            unsigned count{};
+            if (const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), count);
+                ec == std::errc{} && ptr == value.data() + value.size() && count > 0)
+                return count;
+        }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /// the calling thread helps out while it waits for its tasks, so `thread_count - 1` workers are started.
+    explicit thread_pool(const unsigned thread_count = default_thread_count()) {
+        const auto worker_count = std::max(1u, thread_count) - 1;
+        // there's always at least one queue, which the waiting thread drains if there are no workers.
+        for (unsigned i = 0; i < std::max(1u, worker_count); ++i)
+            queues.emplace_back(std::make_unique<worker_queue>());
+        for (unsigned i = 0; i < worker_count; ++i)
+            workers.emplace_back([this, i](const std::stop_token &stop) { work(stop, i); });
+    }
+
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    ~thread_pool() {
+        for (auto &worker: workers)
+            worker.request_stop();
+        wake.notify_all();
+    }
+
+    [[nodiscard]] static thread_pool &global() {
+        static thread_pool pool{};
+        return pool;
+    }
+
+    /// worker threads plus the thread waiting for the results.
+    [[nodiscard]] std::size_t thread_count() const { return workers.size() + 1; }
+
+    void submit(task t) {
+        const auto index = current_pool == this ? current_index
+                                                : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        {
+            auto &[mutex, tasks] = *queues[index];
+            const std::scoped_lock lock{mutex};
+            tasks.push_back(std::move(t));
+            pending.fetch_add(1, std::memory_order_relaxed);
+        }
+        // taking the lock orders the increment before a sleeping worker's predicate check, so no wakeup gets lost.
+        { const std::scoped_lock lock{sleep_mutex}; }
+        wake.notify_one();
+    }
+
+    /// blocks until `done()` holds or there are queued tasks to help with. Whoever makes `done()` true has to call
+    /// `notify_waiters` afterwards.
+    template<std::predicate Predicate>
+    void wait_until(Predicate &&done) {
+        std::unique_lock lock{sleep_mutex};
+        wake.wait(lock, [&] { return done() || pending.load(std::memory_order_relaxed) != 0; });
+    }
+
+    void notify_waiters() {
+        // same as in `submit`, so the change can't slip in between a waiter's check and its wait.
+        { const std::scoped_lock lock{sleep_mutex}; }
+        wake.notify_all();
+    }
+
+    /// runs a single queued task on the calling thread, if there is one.
+    bool try_run_one() {
+        auto t = find_task();
+        if (!t) return false;
+        (*t)();
+        return true;
+    }
+};
+
+/// a set of tasks which can be waited for together. The first exception thrown by any of them is rethrown by `wait`.
+class task_group {
+    thread_pool &pool;
+    std::atomic<std::size_t> outstanding{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    /// helps with queued tasks, and sleeps while there are none but some of the group's are still running.
+    void wait_for_tasks() {
+        const auto done = [this] { return outstanding.load(std::memory_order_acquire) == 0; };
+        while (!done())
+            if (!pool.try_run_one()) pool.wait_until(done);
+    }
+
+public:
+    explicit task_group(thread_pool &pool = thread_pool::global()) : pool{pool} {}
+
+    task_group(const task_group &) = delete;
+    task_group &operator=(const task_group &) = delete;
+
+    ~task_group() { wait_for_tasks(); }
+
+    template<std::invocable F>
+    void run(F &&f) {
+        outstanding.fetch_add(1, std::memory_order_relaxed);
+        pool.submit([this, &pool = pool, f = std::forward<F>(f)] mutable {
+            {
+                auto body = std::move(f);
+                try {
+                    body();
+                } catch (...) {
+                    const std::scoped_lock lock{error_mutex};
+                    if (!error) error = std::current_exception();
+                }
+            }
+            // the group may be gone as soon as this is decremented, so it has to be the last access. The pool (captured
+            // on its own) outlives it.
+            if (outstanding.fetch_sub(1, std::memory_order_release) == 1) pool.notify_waiters();
+        });
+    }
+
+    /// helps running queued tasks (of any group) until every task of this group has finished.
+    void wait() {
+        wait_for_tasks();
+        if (error) std::rethrow_exception(std::exchange(error, nullptr));
+    }
+};
+
+/// size of the chunks a range is split into, aiming at a few chunks per thread so stealing can even out the load.
+[[nodiscard]] inline std::size_t chunk_size(const std::size_t count, const thread_pool &pool,
+                                            const std::size_t grain = 0) {
+    if (grain != 0) return grain;
+    return std::max<std::size_t>(1, count / (pool.thread_count() * 8));
+}
+
+/// calls `body(i)` for every i in [begin; end), spread over the pool.
+template<std::integral I, std::invocable<I> F>
+void parallel_for(thread_pool &pool, const I begin, const I end, F &&body, const std::size_t grain = 0) {
+    if (begin >= end) return;
+    const auto count = static_cast<std::size_t>(end - begin);
+    const auto chunk = chunk_size(count, pool, grain);
+    if (chunk >= count) {
+        for (I i = begin; i < end; ++i)
+            body(i);
+        return;
+    }
+    task_group group{pool};
+    for (std::size_t offset = 0; offset < count; offset += chunk) {
+        const I from = begin + static_cast<I>(offset);
+        const I to = begin + static_cast<I>(std::min(count, offset + chunk));
+        group.run([&body, from, to] {
+            for (I i = from; i < to; ++i)
+                body(i);
+        });
+    }
+    group.wait();
+}
+
+template<std::integral I, std::invocable<I> F>
+void parallel_for(const I begin, const I end, F &&body, const std::size_t grain = 0) {
+    parallel_for(thread_pool::global(), begin, end, std::forward<F>(body), grain);
+}
+
+/// combines `map(i)` for every i in [begin; end). Every chunk is folded on its own, and the partial results are combined
+/// in order, so `combine` only needs to be associative. The result is the same for any amount of threads.
+template<std::integral I, typename T, std::invocable<I> Map, std::invocable<T, std::invoke_result_t<Map, I>> Combine>
+T parallel_reduce(thread_pool &pool, const I begin, const I end, const T identity, Map &&map, Combine &&combine,
+                  const std::size_t grain = 0) {
+    if (begin >= end) return identity;
+    const auto count = static_cast<std::size_t>(end - begin);
+    const auto chunk = chunk_size(count, pool, grain);
+    std::vector<T> partial((count + chunk - 1) / chunk, identity);
+    parallel_for(
+            pool, std::size_t{0}, partial.size(),
+            [&](const std::size_t c) {
+                const I from = begin + static_cast<I>(c * chunk);
+                const I to = begin + static_cast<I>(std::min(count, (c + 1) * chunk));
+                T acc = identity;
+                for (I i = from; i < to; ++i)
+                    acc = combine(std::move(acc), map(i));
+                partial[c] = std::move(acc);
+            },
+            1);
+    T result = identity;
+    for (auto &p: partial)
+        result = combine(std::move(result), std::move(p));
+    return result;
+}
+
+template<std::integral I, typename T, std::invocable<I> Map, std::invocable<T, std::invoke_result_t<Map, I>> Combine>
+T parallel_reduce(const I begin, const I end, const T identity, Map &&map, Combine &&combine,
+                  const std::size_t grain = 0) {
+    return parallel_reduce(thread_pool::global(), begin, end, identity, std::forward<Map>(map),
+                           std::forward<Combine>(combine), grain);
+}
+} // namespace util
+
+#endif // AOC2025_PARALLEL_H
@@ -0,0 +1,36 @@
+#ifndef AOC2025_SCIP_H
+#define AOC2025_SCIP_H
+
+#include <stdexcept>
+
+#include <scip/scip.h>
+#include <scip/scipdefplugins.h>
+
+namespace util {
+/// a SCIP instance with the default plugins, which is freed again on every way out of its scope, exceptions included.
+/// Only for targets linking libscip.
+class scip_instance {
+    SCIP *scip{nullptr};
+
+public:
+    scip_instance() {
+        if (SCIPcreate(&scip) != SCIP_OKAY) throw std::runtime_error("can't create a SCIP instance");
+        if (SCIPincludeDefaultPlugins(scip) != SCIP_OKAY) {
+            SCIPfree(&scip);
+            throw std::runtime_error("can't load the SCIP default plugins");
+        }
+    }
+
+    scip_instance(const scip_instance &) = delete;
+    scip_instance &operator=(const scip_instance &) = delete;
+
+    ~scip_instance() {
+        SCIPfree(&scip);
+        BMScheckEmptyMemory();
+    }
+
+    [[nodiscard]] SCIP *get() const { return scip; }
+};
+} // namespace util
+
+#endif // AOC2025_SCIP_H
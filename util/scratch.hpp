@@ -0,0 +1,95 @@
+#ifndef AOC2025_SCRATCH_H
+#define AOC2025_SCRATCH_H
+
+#include <cstddef>
+#include <cstdio>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace util {
+/// zero-initialized array mapped from an anonymous temporary file. Unlike heap memory, its pages are backed by the file,
+/// so the kernel can write them out and drop them under memory pressure, and arrays larger than the RAM are possible.
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+class scratch_array {
+    T *data{nullptr};
+    std::size_t count{0};
+#ifdef _WIN32
+    HANDLE mapping{nullptr};
+#endif
+
+public:
+    explicit scratch_array(const std::size_t count) : count{count} {
+        if (count == 0) return;
+        const auto bytes = count * sizeof(T);
+#ifdef _WIN32
+        // backed by the paging file rather than a named file, which Windows spills to disk in the same manner.
+        mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(bytes >> 32),
+                                     static_cast<DWORD>(bytes), nullptr);
+        if (mapping) data = static_cast<T *>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+        if (!data) {
+            if (mapping) CloseHandle(mapping);
+            throw std::runtime_error(std::format("can't map {} bytes of scratch space", bytes));
+        }
+#else
+        // the temporary file is already unlinked, the mapping keeps it alive until it's unmapped.
+        std::FILE *file = std::tmpfile();
+        if (!file) throw std::runtime_error("can't create a scratch file");
+        void *p = MAP_FAILED;
+        if (ftruncate(fileno(file), static_cast<off_t>(bytes)) == 0)
+            p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fileno(file), 0);
+        std::fclose(file);
+        if (p == MAP_FAILED) throw std::runtime_error(std::format("can't map {} bytes of scratch space", bytes));
+        data = static_cast<T *>(p);
+#endif
+    }
+
+    scratch_array(const scratch_array &) = delete;
+    scratch_array &operator=(const scratch_array &) = delete;
+
+    scratch_array(scratch_array &&other) noexcept :
+        data{std::exchange(other.data, nullptr)}, count{std::exchange(other.count, 0)} {
+#ifdef _WIN32
+        mapping = std::exchange(other.mapping, nullptr);
+#endif
+    }
+
+    scratch_array &operator=(scratch_array &&other) noexcept {
+        std::swap(data, other.data);
+        std::swap(count, other.count);
+#ifdef _WIN32
+        std::swap(mapping, other.mapping);
+#endif
+        return *this;
+    }
+
+    ~scratch_array() {
+        if (!data) return;
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle(mapping);
+#else
+        munmap(data, count * sizeof(T));
+#endif
+    }
+
+    [[nodiscard]] std::span<T> span() const { return {data, count}; }
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] T &operator[](const std::size_t i) const { return data[i]; }
+};
+} // namespace util
+
+#endif // AOC2025_SCRATCH_H